@@ -0,0 +1,343 @@
+﻿#include "Bench.h"
+#include "Core/Context.h"
+#include "Network/Service.h"
+#include "Network/Event.h"
+#include "Network/Packet.h"
+#include <algorithm>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif // __linux__
+
+// 재접속 폭주처럼 수천 개의 연결이 한꺼번에 들어올 때 ServerService가 초당 수락하는 연결 수와 첫 바이트까지의 시간 비교
+// - acceptor 하나: SharedContext (IO 스레드가 io_context 하나를 공유하고 acceptor 하나가 수락)
+// - IO 스레드마다 acceptor: ContextPerThread (SO_REUSEPORT로 같은 포트에 바인딩한 acceptor를 커널이 분산), socket과 io_uring 백엔드
+// 서버는 메인 스레드 역할의 이벤트 스레드에서 수락한 세션을 시작하고 환영 패킷 하나를 보낸다
+// 첫 바이트까지의 시간은 클라이언트가 connect()를 호출한 시각부터 환영 패킷을 처음 받은 시각까지이며, 이벤트 스레드의 1 ms 폴링 간격이 들어간다
+//
+// 사용법: AcceptBench [연결 수=4000] [IO 스레드 수=4]
+#if defined(__linux__)
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint16_t BenchPort = 12350;
+    constexpr net::PacketId WelcomePacketId = 1;
+    constexpr size_t WelcomePayloadSize = 16;
+
+    struct BenchConfig
+    {
+        size_t connectionCount = 4000;
+        size_t threadCount = 4;
+    };
+
+    net::SendBufferChunkPtr makeWelcomeChunk()
+    {
+        const size_t totalSize = sizeof(net::PacketHeader) + WelcomePayloadSize;
+        net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+        auto* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+        header->size = static_cast<net::PacketSize>(totalSize);
+        header->id = WelcomePacketId;
+        std::memset(header + 1, 'w', WelcomePayloadSize);
+
+        chunk->onWritten(totalSize);
+        chunk->close();
+
+        return chunk;
+    }
+
+    // 수락한 세션을 시작하자마자 환영 패킷을 보내는 서버
+    class WelcomeServer
+    {
+    public:
+        WelcomeServer(net::IoThreadModel threadModel, net::TransportBackend backend, size_t threadCount)
+            : m_ioThreadPool(threadCount, threadModel)
+            , m_welcome(makeWelcomeChunk())
+        {
+            m_service = net::ServerService::createInstance(
+                m_ioThreadPool, m_serviceEventQueue, BenchPort,
+                [this](net::SessionTransportPtr&& transport)
+                {
+                    // 수락한 IO 스레드에서 호출된다
+                    m_acceptedCount.fetch_add(1);
+                    m_lastAcceptTime.store(bench::Clock::now().time_since_epoch().count());
+                    return net::Session::createInstance(std::move(transport), m_sessionEventQueue, m_ioThreadPool.getThreadModel());
+                });
+            m_service->setTransportBackend(backend);
+        }
+
+        void start()
+        {
+            m_running = true;
+            m_ioThreadPool.run();
+            m_service->start();
+
+            m_eventThread = std::thread(
+                [this]()
+                {
+                    while (m_running.load())
+                    {
+                        processEvents();
+                        std::this_thread::sleep_for(1ms);
+                    }
+                });
+        }
+
+        void stop()
+        {
+            m_running = false;
+            m_eventThread.join();
+
+            for (auto& [sessionId, session] : m_sessions)
+            {
+                session->stop();
+            }
+
+            m_service->stop();
+
+            // 세션과 서비스가 닫힐 때까지 기다린 뒤 IO 스레드 종료 (닫히기 전에 멈추면 리스닝 소켓이 남는다)
+            const auto deadline = bench::Clock::now() + 5s;
+            while ((!m_sessions.empty() || !m_serviceClosed) && (bench::Clock::now() < deadline))
+            {
+                processEvents();
+                std::this_thread::sleep_for(1ms);
+            }
+
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+        size_t getAcceptedCount() const { return m_acceptedCount.load(); }
+
+        bench::Clock::time_point getLastAcceptTime() const
+        {
+            return bench::Clock::time_point(bench::Clock::duration(m_lastAcceptTime.load()));
+        }
+
+        net::TransportBackend getBackend() const { return m_service->getTransportBackend(); }
+
+    private:
+        void processEvents()
+        {
+            net::ServiceEventPtr serviceEvent;
+            while (m_serviceEventQueue.pop(serviceEvent))
+            {
+                if (serviceEvent->type == net::ServiceEventType::Close)
+                {
+                    m_serviceClosed = true;
+                    continue;
+                }
+
+                if (serviceEvent->type != net::ServiceEventType::Accept)
+                {
+                    continue;
+                }
+
+                const net::SessionPtr& session = static_cast<net::ServiceAcceptEvent*>(serviceEvent.get())->session;
+                m_sessions[session->getSessionId()] = session;
+                session->start();
+                session->send(m_welcome);
+            }
+
+            net::SessionEventPtr sessionEvent;
+            while (m_sessionEventQueue.pop(sessionEvent))
+            {
+                if (sessionEvent->type != net::SessionEventType::Close)
+                {
+                    continue;
+                }
+
+                auto it = m_sessions.find(sessionEvent->sessionId);
+                if (it != m_sessions.end())
+                {
+                    m_ioThreadPool.releaseSessionContext(asio::query(it->second->getExecutor(), asio::execution::context));
+                    m_sessions.erase(it);
+                }
+            }
+        }
+
+    private:
+        std::atomic<bool> m_running = false;
+        std::atomic<size_t> m_acceptedCount = 0;
+        std::atomic<bench::Clock::rep> m_lastAcceptTime = 0;
+        bool m_serviceClosed = false;
+        net::IoThreadPool m_ioThreadPool;
+        net::ServiceEventQueue m_serviceEventQueue;
+        net::SessionEventQueue m_sessionEventQueue;
+        net::ServerServicePtr m_service;
+        net::SendBufferChunkPtr m_welcome;
+        std::unordered_map<net::SessionId, net::SessionPtr> m_sessions; // 이벤트 스레드에서만 사용
+        std::thread m_eventThread;
+    };
+
+    // 논블로킹 connect()를 멈추지 않고 연달아 호출하고, 연결마다 첫 바이트를 받은 시각을 기록하는 클라이언트
+    class StormClient
+    {
+    public:
+        explicit StormClient(size_t connectionCount)
+            : m_connections(connectionCount)
+        {
+            m_epollFd = ::epoll_create1(0);
+        }
+
+        ~StormClient()
+        {
+            for (Connection& connection : m_connections)
+            {
+                if (connection.fd >= 0)
+                {
+                    ::close(connection.fd);
+                }
+            }
+
+            ::close(m_epollFd);
+        }
+
+        // 모든 연결이 첫 바이트를 받거나 timeout이 지날 때까지 실행하고 첫 바이트까지의 시간(ns)을 반환
+        std::vector<uint64_t> run(std::chrono::nanoseconds timeout)
+        {
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(BenchPort);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            std::vector<uint64_t> timesToFirstByte;
+            timesToFirstByte.reserve(m_connections.size());
+
+            std::vector<epoll_event> events(1024);
+            uint8_t buffer[256];
+
+            auto poll = [&](int timeoutMs)
+            {
+                const int eventCount = ::epoll_wait(m_epollFd, events.data(), static_cast<int>(events.size()), timeoutMs);
+                const auto now = bench::Clock::now();
+                for (int i = 0; i < eventCount; ++i)
+                {
+                    Connection& connection = m_connections[events[i].data.u64];
+                    if (connection.received)
+                    {
+                        continue;
+                    }
+
+                    if (::recv(connection.fd, buffer, sizeof(buffer), 0) > 0)
+                    {
+                        connection.received = true;
+                        timesToFirstByte.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - connection.connectTime).count());
+                    }
+                }
+            };
+
+            m_startTime = bench::Clock::now();
+            for (size_t i = 0; i < m_connections.size(); ++i)
+            {
+                Connection& connection = m_connections[i];
+                connection.fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+                connection.connectTime = bench::Clock::now();
+                if ((::connect(connection.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) && (errno != EINPROGRESS))
+                {
+                    spdlog::error("[AcceptBench] 연결 실패: {} ({})", i, std::strerror(errno));
+                    break;
+                }
+
+                epoll_event event = {};
+                event.events = EPOLLIN;
+                event.data.u64 = i;
+                ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, connection.fd, &event);
+
+                // 연결을 만드는 사이사이 도착한 첫 바이트를 받아 시각이 밀리지 않게 한다
+                if ((i % 64) == 63)
+                {
+                    poll(0);
+                }
+            }
+
+            const auto deadline = bench::Clock::now() + timeout;
+            while ((timesToFirstByte.size() < m_connections.size()) && (bench::Clock::now() < deadline))
+            {
+                poll(10);
+            }
+
+            return timesToFirstByte;
+        }
+
+        bench::Clock::time_point getStartTime() const { return m_startTime; }
+
+    private:
+        struct Connection
+        {
+            int fd = -1;
+            bool received = false;
+            bench::Clock::time_point connectTime;
+        };
+
+    private:
+        std::vector<Connection> m_connections;
+        int m_epollFd = -1;
+        bench::Clock::time_point m_startTime;
+    };
+
+    double getPercentileUs(const std::vector<uint64_t>& sortedTimes, double percentile)
+    {
+        if (sortedTimes.empty())
+        {
+            return 0.0;
+        }
+
+        const size_t index = std::min(static_cast<size_t>(percentile * sortedTimes.size()), sortedTimes.size() - 1);
+        return sortedTimes[index] / 1000.0;
+    }
+
+    void runStorm(const char* name, net::IoThreadModel threadModel, net::TransportBackend backend, const BenchConfig& config)
+    {
+        WelcomeServer server(threadModel, backend, config.threadCount);
+        server.start();
+
+        // 클라이언트 연결은 서버를 멈춘 뒤에 닫는다
+        StormClient client(config.connectionCount);
+        std::vector<uint64_t> timesToFirstByte = client.run(10s);
+        std::sort(timesToFirstByte.begin(), timesToFirstByte.end());
+
+        const double acceptSeconds = std::chrono::duration<double>(server.getLastAcceptTime() - client.getStartTime()).count();
+
+        spdlog::info("[AcceptBench] {}: {} of {} accepted, {:.0f} accepts/s, time to first byte p50 {:.0f} us, p99 {:.0f} us, max {:.0f} us",
+            name, server.getAcceptedCount(), config.connectionCount,
+            server.getAcceptedCount() / std::max(acceptSeconds, 1e-9),
+            getPercentileUs(timesToFirstByte, 0.50), getPercentileUs(timesToFirstByte, 0.99), getPercentileUs(timesToFirstByte, 1.0));
+
+        server.stop();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    BenchConfig config;
+    config.connectionCount = std::max<size_t>(bench::getArgument(argc, argv, 1, config.connectionCount), 1);
+    config.threadCount = std::max<size_t>(bench::getArgument(argc, argv, 2, config.threadCount), 1);
+
+    runStorm("one acceptor                 ", net::IoThreadModel::SharedContext, net::TransportBackend::Socket, config);
+    runStorm("acceptor per thread, socket  ", net::IoThreadModel::ContextPerThread, net::TransportBackend::Socket, config);
+
+    if (net::isTransportBackendAvailable(net::TransportBackend::Uring))
+    {
+        runStorm("acceptor per thread, io_uring", net::IoThreadModel::ContextPerThread, net::TransportBackend::Uring, config);
+    }
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
+#else
+int main()
+{
+    spdlog::error("[AcceptBench] Linux에서만 실행할 수 있다");
+    return 0;
+}
+#endif // __linux__
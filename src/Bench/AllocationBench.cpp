@@ -0,0 +1,159 @@
+﻿#include "Bench.h"
+#include "Network/Buffer.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// 송수신 경로의 힙 할당 횟수
+// - 송신 버퍼: 보낸 1 MB마다의 할당 횟수 (블록 풀 이전의 버퍼마다 vector를 새로 만드는 방식과 비교)
+//
+// 할당 횟수는 이 실행 파일에서 전역 operator new를 바꿔 세므로, 측정하는 동안의 모든 할당이 포함된다
+//
+// 사용법: AllocationBench [보낼 크기(MB)=64]
+namespace
+{
+    std::atomic<uint64_t> s_allocationCount = 0;
+
+    uint64_t getAllocationCount()
+    {
+        return s_allocationCount.load(std::memory_order_relaxed);
+    }
+}
+
+void* operator new(size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    // 송신 큐와 소켓에 머무는 동안 살아 있는 청크 수 (이만큼 지난 청크는 IO 스레드가 보내고 해제한 것으로 본다)
+    constexpr size_t InFlightChunkCount = 64;
+
+    class LegacySendBuffer;
+
+    // 블록 풀 이전의 SendBufferChunk: 메시지마다 make_shared로 만들고 버퍼를 잡고 있다
+    struct LegacySendBufferChunk
+    {
+        std::shared_ptr<LegacySendBuffer> owner;
+        uint8_t* data = nullptr;
+    };
+
+    // 블록 풀 이전의 SendBuffer: 4 KiB마다 make_shared와 0으로 초기화한 vector를 새로 할당
+    class LegacySendBuffer
+        : public std::enable_shared_from_this<LegacySendBuffer>
+    {
+    public:
+        static constexpr size_t DefaultSize = 4096;
+
+        LegacySendBuffer() : m_buffer(DefaultSize) {}
+
+        size_t getFreeSize() const { return m_buffer.size() - m_offset; }
+
+        std::shared_ptr<LegacySendBufferChunk> open(size_t size)
+        {
+            auto chunk = std::make_shared<LegacySendBufferChunk>(LegacySendBufferChunk{ shared_from_this(), m_buffer.data() + m_offset });
+            m_offset += size;
+            return chunk;
+        }
+
+    private:
+        std::vector<uint8_t> m_buffer;
+        size_t m_offset = 0;
+    };
+
+    // 보낸 1 MB마다의 할당 횟수와 메시지당 시간을 출력
+    template<typename TOpen>
+    void measureSend(const char* name, size_t messageSize, size_t megabytes, TOpen&& open)
+    {
+        const size_t messageCount = megabytes * 1024 * 1024 / messageSize;
+
+        // 청크 보관 자리는 미리 만들어 측정 중 할당에 섞이지 않도록 한다
+        std::vector<decltype(open(messageSize))> inFlight(InFlightChunkCount);
+
+        const net::SendBufferPoolStats poolBefore = net::SendBufferPool::getStats();
+        const uint64_t allocationsBefore = getAllocationCount();
+        const auto startTime = bench::Clock::now();
+
+        for (size_t i = 0; i < messageCount; ++i)
+        {
+            auto chunk = open(messageSize);
+            inFlight[i % InFlightChunkCount] = std::move(chunk);
+        }
+        std::fill(inFlight.begin(), inFlight.end(), nullptr);
+
+        const double elapsed = std::chrono::duration<double, std::nano>(bench::Clock::now() - startTime).count();
+        const uint64_t allocations = getAllocationCount() - allocationsBefore;
+        const net::SendBufferPoolStats poolAfter = net::SendBufferPool::getStats();
+
+        // 메시지마다 만드는 청크 하나를 뺀 나머지가 버퍼(블록) 단위 할당
+        spdlog::info("[AllocationBench] send {:>5} B messages, {}: {:.0f} allocations/MB ({:.0f} per buffer, {:.0f} blocks/MB from the system), {:.1f} ns/msg",
+            messageSize, name,
+            static_cast<double>(allocations) / megabytes,
+            static_cast<double>(allocations - std::min<uint64_t>(allocations, messageCount)) / megabytes,
+            static_cast<double>(poolAfter.allocatedBlocks - poolBefore.allocatedBlocks) / megabytes,
+            elapsed / messageCount);
+    }
+
+    void benchSendBuffers(size_t megabytes)
+    {
+        for (size_t messageSize : { 64, 1024, 16384 })
+        {
+            // 이전 방식은 DefaultSize보다 큰 청크를 열지 못했다
+            if (messageSize <= LegacySendBuffer::DefaultSize)
+            {
+                std::shared_ptr<LegacySendBuffer> current = std::make_shared<LegacySendBuffer>();
+                measureSend(
+                    "vector per buffer", messageSize, megabytes,
+                    [&current](size_t size)
+                    {
+                        if (current->getFreeSize() < size)
+                        {
+                            current = std::make_shared<LegacySendBuffer>();
+                        }
+
+                        std::shared_ptr<LegacySendBufferChunk> chunk = current->open(size);
+                        std::memset(chunk->data, 0x5A, size);
+                        return chunk;
+                    });
+            }
+
+            measureSend(
+                "pooled blocks    ", messageSize, megabytes,
+                [](size_t size)
+                {
+                    net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(size);
+                    std::memset(chunk->getWritePtr(), 0x5A, size);
+                    chunk->onWritten(size);
+                    chunk->close();
+                    return chunk;
+                });
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t megabytes = std::max<size_t>(bench::getArgument(argc, argv, 1, 64), 1);
+
+    benchSendBuffers(megabytes);
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif // !_WIN32
+
+// 벤치마크 프로그램이 함께 쓰는 측정 도구
+// 결과는 변경 기록에 적은 수치와 같은 단위(메시지당 ns, 초당 메시지 수)로 출력한다
+namespace bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 최적화로 결과가 사라지지 않도록 값을 누적 (마지막에 한 번 출력)
+    inline volatile uint64_t s_sink = 0;
+
+    inline void consume(uint64_t value)
+    {
+        s_sink = s_sink + value;
+    }
+
+    // 한 번의 실행이 operationCount개를 처리하는 function을 repeatCount번 실행하고 하나당 평균 시간(ns) 반환
+    // 첫 실행은 캐시와 풀을 채우는 준비 실행으로 측정하지 않는다
+    template<typename TFunction>
+    double measureNs(size_t operationCount, size_t repeatCount, TFunction&& function)
+    {
+        function();
+
+        const auto startTime = Clock::now();
+        for (size_t i = 0; i < repeatCount; ++i)
+        {
+            function();
+        }
+
+        const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - startTime).count();
+        return elapsed / static_cast<double>(operationCount * repeatCount);
+    }
+
+    // 프로세스의 모든 스레드가 사용한 CPU 시간
+    inline std::chrono::nanoseconds getProcessCpuTime()
+    {
+#if defined(_WIN32)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        ::GetProcessTimes(::GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+        const uint64_t ticks =
+            ((static_cast<uint64_t>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime) +
+            ((static_cast<uint64_t>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime);
+        return std::chrono::nanoseconds(ticks * 100);
+#else
+        timespec time;
+        ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+    }
+
+    // 호출한 스레드가 사용한 CPU 시간
+    inline std::chrono::nanoseconds getThreadCpuTime()
+    {
+#if defined(_WIN32)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        ::GetThreadTimes(::GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime);
+        const uint64_t ticks =
+            ((static_cast<uint64_t>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime) +
+            ((static_cast<uint64_t>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime);
+        return std::chrono::nanoseconds(ticks * 100);
+#else
+        timespec time;
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+    }
+
+    // argv[index]를 정수로 읽고 없으면 기본값
+    inline size_t getArgument(int argc, char* argv[], int index, size_t defaultValue)
+    {
+        return (index < argc) ? std::strtoul(argv[index], nullptr, 10) : defaultValue;
+    }
+}
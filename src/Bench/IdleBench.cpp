@@ -0,0 +1,398 @@
+﻿#include "Bench.h"
+#include "Core/Context.h"
+#include "Network/Session.h"
+#include "Network/Event.h"
+#include "Network/IdleMonitor.h"
+#include "Network/Packet.h"
+#include <algorithm>
+#include <thread>
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif // __linux__
+
+// 응답 없이 버려진 연결이 대량으로 남아 있을 때의 메모리와 방송 비용을 IdleSessionMonitor로 정리하기 전후로 비교
+// - 힙: malloc이 사용 중인 바이트 (벤치가 가진 클라이언트 소켓 객체도 들어간다), RSS
+// - 방송: SessionManager::broadcast() 한 번에 메인 스레드가 쓴 CPU 시간과, 모든 수신자의 송신이 끝날 때까지 프로세스가 쓴 CPU 시간
+// 연결은 127.0.0.1 TCP 연결이라 한 연결에 파일 디스크립터 두 개를 쓰므로 연결 수는 RLIMIT_NOFILE로 제한되며, 커널 소켓 버퍼는 들어가지 않는다
+// 살아 있는 세션에는 IdleTimeout보다 짧은 간격으로 클라이언트 소켓에서 하트비트 크기의 패킷을 보내 정리되지 않게 한다
+//
+// 사용법: IdleBench [버려진 연결 수=9000] [살아 있는 연결 수=500] [방송 횟수=20] [IO 스레드 수=2]
+#if defined(__linux__)
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr net::PacketId ChatPacketId = 1;
+    constexpr net::PacketId HeartbeatPacketId = 2;
+    constexpr size_t ChatPayloadSize = 32;
+    constexpr size_t HeartbeatPayloadSize = 16;
+
+    constexpr std::chrono::milliseconds IdleTimeout = 500ms;
+    constexpr std::chrono::milliseconds HeartbeatInterval = 100ms;
+    constexpr std::chrono::milliseconds TickInterval = 10ms;
+
+    // 리스너, epoll, 로그 파일 등 연결 외에 쓰는 파일 디스크립터 여유
+    constexpr size_t ReservedFileCount = 64;
+
+    struct BenchConfig
+    {
+        size_t abandonedCount = 9000;
+        size_t liveCount = 500;
+        size_t broadcastCount = 20;
+        size_t threadCount = 2;
+    };
+
+    struct MemoryUsage
+    {
+        double heapBytes = 0.0;
+        double residentBytes = 0.0;
+    };
+
+    struct BroadcastCost
+    {
+        double mainThreadUs = 0.0;  // 방송 한 번당 메인 스레드 CPU 시간
+        double totalCpuUs = 0.0;    // 방송 한 번당
+    };
+
+    MemoryUsage getMemoryUsage()
+    {
+        MemoryUsage usage;
+
+        const struct mallinfo2 info = ::mallinfo2();
+        usage.heapBytes = static_cast<double>(info.uordblks + info.hblkhd);
+
+        size_t totalPages = 0;
+        size_t residentPages = 0;
+        if (FILE* file = std::fopen("/proc/self/statm", "r"))
+        {
+            if (std::fscanf(file, "%zu %zu", &totalPages, &residentPages) != 2)
+            {
+                residentPages = 0;
+            }
+            std::fclose(file);
+        }
+        usage.residentBytes = static_cast<double>(residentPages * ::sysconf(_SC_PAGESIZE));
+
+        return usage;
+    }
+
+    // 파일 디스크립터 한도를 최대로 올리고, 한 연결에 두 개씩 쓸 수 있는 연결 수 반환
+    size_t raiseConnectionLimit()
+    {
+        rlimit limit{};
+        if (::getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        {
+            return 0;
+        }
+
+        if (limit.rlim_cur < limit.rlim_max)
+        {
+            limit.rlim_cur = limit.rlim_max;
+            ::setrlimit(RLIMIT_NOFILE, &limit);
+            ::getrlimit(RLIMIT_NOFILE, &limit);
+        }
+
+        const size_t fileCount = static_cast<size_t>(limit.rlim_cur);
+        return (ReservedFileCount < fileCount) ? (fileCount - ReservedFileCount) / 2 : 0;
+    }
+
+    net::SendBufferChunkPtr makePacket(net::PacketId packetId, size_t payloadSize)
+    {
+        const size_t totalSize = sizeof(net::PacketHeader) + payloadSize;
+        net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+        auto* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+        header->size = static_cast<net::PacketSize>(totalSize);
+        header->id = packetId;
+        std::memset(header + 1, 'x', payloadSize);
+
+        chunk->onWritten(totalSize);
+        chunk->close();
+
+        return chunk;
+    }
+
+    // 127.0.0.1 연결로 만든 세션과 IdleSessionMonitor를 가진 메인 스레드 (WorldServer의 세션 관리와 같은 흐름)
+    // 클라이언트 소켓은 실행하지 않는 io_context에 두고 동기 호출로만 쓴다
+    class IdleServer
+    {
+    public:
+        explicit IdleServer(const BenchConfig& config)
+            : m_config(config)
+            , m_ioThreadPool(config.threadCount, net::IoThreadModel::ContextPerThread)
+            , m_acceptor(m_clientContext, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+            , m_idleMonitor(m_sessionManager, IdleTimeout)
+            , m_heartbeat(makePacket(HeartbeatPacketId, HeartbeatPayloadSize))
+        {
+            const asio::ip::tcp::endpoint endpoint = m_acceptor.local_endpoint();
+
+            for (size_t i = 0; i < config.abandonedCount + config.liveCount; ++i)
+            {
+                const bool live = (i < config.liveCount);
+
+                asio::ip::tcp::socket client(m_clientContext);
+                client.connect(endpoint);
+
+                net::SessionPtr session = net::Session::createInstance(
+                    m_acceptor.accept(m_ioThreadPool.acquireSessionContext()),
+                    m_eventQueue,
+                    net::IoThreadModel::ContextPerThread);
+
+                (live ? m_liveClients : m_abandonedClients).push_back(std::move(client));
+
+                session->start();
+                m_sessionManager.addSession(session);
+                m_idleMonitor.addSession(session);
+                m_sessions.push_back(std::move(session));
+            }
+
+            m_acceptor.close();
+            m_sessionCount = m_sessions.size();
+            m_ioThreadPool.run();
+        }
+
+        ~IdleServer()
+        {
+            m_sessionManager.stopAllSessions();
+
+            const auto deadline = bench::Clock::now() + 10s;
+            while (!m_sessionManager.isEmpty() && (bench::Clock::now() < deadline))
+            {
+                processEvents();
+                std::this_thread::sleep_for(1ms);
+            }
+
+            m_sessions.clear();
+            m_ioThreadPool.reset();
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+        size_t getSessionCount() const { return m_sessionCount; }
+
+        BroadcastCost measureBroadcast()
+        {
+            const net::SendBufferChunkPtr chunk = makePacket(ChatPacketId, ChatPayloadSize);
+
+            // 준비 실행
+            m_sessionManager.broadcast(chunk);
+            waitSent();
+
+            std::chrono::nanoseconds mainThreadTime(0);
+            std::chrono::nanoseconds waitCpuTime(0);
+            const std::chrono::nanoseconds startCpuTime = bench::getProcessCpuTime();
+
+            for (size_t i = 0; i < m_config.broadcastCount; ++i)
+            {
+                const std::chrono::nanoseconds startThreadCpuTime = bench::getThreadCpuTime();
+                m_sessionManager.broadcast(chunk);
+                mainThreadTime += bench::getThreadCpuTime() - startThreadCpuTime;
+
+                // 방송마다 송신이 끝나길 기다려 IO 스레드의 비용이 다음 방송과 겹치지 않게 한다
+                const std::chrono::nanoseconds waitStartCpuTime = bench::getThreadCpuTime();
+                waitSent();
+                waitCpuTime += bench::getThreadCpuTime() - waitStartCpuTime;
+            }
+
+            const std::chrono::nanoseconds totalCpuTime = bench::getProcessCpuTime() - startCpuTime - waitCpuTime;
+
+            BroadcastCost cost;
+            cost.mainThreadUs = std::chrono::duration<double, std::micro>(mainThreadTime).count() / static_cast<double>(m_config.broadcastCount);
+            cost.totalCpuUs = std::chrono::duration<double, std::micro>(totalCpuTime).count() / static_cast<double>(m_config.broadcastCount);
+            return cost;
+        }
+
+        // 버려진 세션이 모두 정리될 때까지 틱을 돌리고 걸린 시간 반환
+        std::chrono::milliseconds reapAbandoned()
+        {
+            const auto startTime = bench::Clock::now();
+            const auto deadline = startTime + IdleTimeout * 20;
+
+            // 연결과 방송 측정이 IdleTimeout보다 오래 걸렸을 수 있으므로 살아 있는 세션이 하트비트를 받은 뒤에 정리를 시작한다
+            sendHeartbeats();
+            for (size_t i = 0; i < m_config.liveCount; ++i)
+            {
+                while (m_sessions[i]->getLastReceiveTime() < startTime)
+                {
+                    processEvents();
+                    std::this_thread::sleep_for(100us);
+                }
+            }
+
+            auto nextHeartbeatTime = bench::Clock::now() + HeartbeatInterval;
+
+            while ((m_config.liveCount < m_sessionCount) && (bench::Clock::now() < deadline))
+            {
+                const auto now = bench::Clock::now();
+                if (nextHeartbeatTime <= now)
+                {
+                    sendHeartbeats();
+                    nextHeartbeatTime = now + HeartbeatInterval;
+                }
+
+                m_idleMonitor.update(now);
+                processEvents();
+                std::this_thread::sleep_for(TickInterval);
+            }
+
+            const auto reapTime = std::chrono::duration_cast<std::chrono::milliseconds>(bench::Clock::now() - startTime);
+
+            // 정리된 세션을 보관하던 목록과 상대편 클라이언트 소켓도 비운다
+            m_sessions.erase(
+                std::remove_if(m_sessions.begin(), m_sessions.end(),
+                    [](const net::SessionPtr& session)
+                    {
+                        return !session->isRunning();
+                    }),
+                m_sessions.end());
+            m_abandonedClients.clear();
+
+            return reapTime;
+        }
+
+    private:
+        // 살아 있는 세션의 클라이언트 소켓으로 하트비트 크기의 패킷을 보낸다
+        void sendHeartbeats()
+        {
+            for (asio::ip::tcp::socket& client : m_liveClients)
+            {
+                asio::error_code error;
+                asio::write(client, asio::buffer(m_heartbeat->getReadPtr(), m_heartbeat->getWrittenSize()), error);
+            }
+        }
+
+        // 모든 세션이 지금까지 방송한 청크를 송신할 때까지 대기
+        void waitSent()
+        {
+            ++m_broadcastCount;
+
+            for (const net::SessionPtr& session : m_sessions)
+            {
+                while (session->isRunning() && (session->getSentChunkCount() < m_broadcastCount))
+                {
+                    std::this_thread::sleep_for(100us);
+                }
+            }
+        }
+
+        void processEvents()
+        {
+            net::SessionEventPtr event;
+            while (m_eventQueue.pop(event))
+            {
+                net::SessionPtr session = m_sessionManager.findSession(event->sessionId);
+                if (!session)
+                {
+                    continue;
+                }
+
+                if (event->type == net::SessionEventType::Receive)
+                {
+                    if (!session->isRunning())
+                    {
+                        // 종료 중인 세션의 수신 버퍼는 IO 스레드가 정리한다
+                        continue;
+                    }
+
+                    // 받은 하트비트는 버린다
+                    net::PacketView packet;
+                    while (session->getFrontPacket(packet))
+                    {
+                        session->popFrontPacket();
+                    }
+
+                    session->receive();
+                }
+                else if (event->type == net::SessionEventType::Close)
+                {
+                    m_ioThreadPool.releaseSessionContext(asio::query(session->getExecutor(), asio::execution::context));
+                    m_sessionManager.removeSession(event->sessionId);
+                    --m_sessionCount;
+                }
+            }
+        }
+
+    private:
+        const BenchConfig& m_config;
+        net::IoThreadPool m_ioThreadPool;
+        asio::io_context m_clientContext;
+        asio::ip::tcp::acceptor m_acceptor;
+        net::SessionEventQueue m_eventQueue;
+        net::SessionManager m_sessionManager;
+        net::IdleSessionMonitor m_idleMonitor;
+        net::SendBufferChunkPtr m_heartbeat;
+        std::vector<net::SessionPtr> m_sessions;
+        std::vector<asio::ip::tcp::socket> m_liveClients;
+        std::vector<asio::ip::tcp::socket> m_abandonedClients;
+        size_t m_sessionCount = 0;
+        uint64_t m_broadcastCount = 0;
+    };
+
+    void printState(const char* name, const IdleServer& server, const MemoryUsage& baseline, const BroadcastCost& cost)
+    {
+        const MemoryUsage usage = getMemoryUsage();
+        const double heapBytes = usage.heapBytes - baseline.heapBytes;
+
+        spdlog::info("[IdleBench] {}: {} sessions, heap {:.1f} MB ({:.0f} B/session), RSS {:.1f} MB",
+            name, server.getSessionCount(),
+            heapBytes / (1024.0 * 1024.0),
+            heapBytes / static_cast<double>(std::max<size_t>(server.getSessionCount(), 1)),
+            (usage.residentBytes - baseline.residentBytes) / (1024.0 * 1024.0));
+        spdlog::info("[IdleBench] {}: broadcast main thread {:.1f} us, total CPU {:.1f} us ({:.1f} ns per session)",
+            name, cost.mainThreadUs, cost.totalCpuUs,
+            cost.totalCpuUs * 1000.0 / static_cast<double>(std::max<size_t>(server.getSessionCount(), 1)));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    BenchConfig config;
+    config.abandonedCount = bench::getArgument(argc, argv, 1, config.abandonedCount);
+    config.liveCount = std::max<size_t>(bench::getArgument(argc, argv, 2, config.liveCount), 1);
+    config.broadcastCount = std::max<size_t>(bench::getArgument(argc, argv, 3, config.broadcastCount), 1);
+    config.threadCount = std::max<size_t>(bench::getArgument(argc, argv, 4, config.threadCount), 1);
+
+    const size_t connectionLimit = raiseConnectionLimit();
+    if (connectionLimit < config.abandonedCount + config.liveCount)
+    {
+        spdlog::warn("[IdleBench] 파일 디스크립터 한도로 버려진 연결 수를 줄인다: {} -> {}",
+            config.abandonedCount, (config.liveCount < connectionLimit) ? connectionLimit - config.liveCount : 0);
+        config.liveCount = std::min(config.liveCount, connectionLimit);
+        config.abandonedCount = connectionLimit - config.liveCount;
+    }
+
+    {
+        const MemoryUsage baseline = getMemoryUsage();
+        IdleServer server(config);
+
+        const BroadcastCost before = server.measureBroadcast();
+        printState("before reaping", server, baseline, before);
+
+        const std::chrono::milliseconds reapTime = server.reapAbandoned();
+        spdlog::info("[IdleBench] reaped {} abandoned sessions in {} ms (idle timeout {} ms, batch {})",
+            config.abandonedCount, reapTime.count(), IdleTimeout.count(), net::IdleSessionMonitor::DefaultReapBatchSize);
+
+        // 해제한 메모리를 운영 체제에 돌려준 뒤 측정 (RSS 비교용)
+        ::malloc_trim(0);
+
+        const BroadcastCost after = server.measureBroadcast();
+        printState("after reaping ", server, baseline, after);
+    }
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
+#else
+int main()
+{
+    spdlog::error("[IdleBench] Linux에서만 실행할 수 있다");
+    return 0;
+}
+#endif // __linux__
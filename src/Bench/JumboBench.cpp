@@ -0,0 +1,240 @@
+﻿#include "Bench.h"
+#include "Core/Context.h"
+#include "Network/Session.h"
+#include "Network/Event.h"
+#include "Protocol/Serializer.h"
+#include <thread>
+
+// 한 패킷에 들어가지 않는 큰 메시지(기본 1 MB)의 처리량
+// - 직렬화: MessageSerializer가 조각 패킷으로 나눠 청크 하나에 쓰는 비용
+// - 세션 간 전송: 127.0.0.1 TCP로 연결한 두 세션 사이에서 조각을 보내고, 메인 스레드가 받는 쪽의 조각을 재조립해 메시지 하나로 꺼낼 때까지
+//
+// 사용법: JumboBench [메시지 크기(KB)=1024] [메시지 수=200] [한 번에 보내는 메시지 수=2]
+namespace
+{
+    using namespace std::chrono_literals;
+
+    struct BenchConfig
+    {
+        size_t messageSize = 1024 * 1024;
+        size_t messageCount = 200;
+        size_t windowSize = 2;
+    };
+
+    proto::S2C_Chat makeChat(size_t messageSize)
+    {
+        proto::S2C_Chat chat;
+        chat.set_sender_name("player-12");
+        chat.set_server_message_id(12345);
+        chat.set_server_sent_at_ms(1700000000000);
+
+        // 나머지 필드를 뺀 만큼 본문으로 채워 직렬화 크기를 messageSize에 맞춘다
+        const size_t fieldsSize = chat.ByteSizeLong();
+        const size_t contentSize = (messageSize > fieldsSize + 4) ? messageSize - fieldsSize - 4 : 0;
+        chat.set_content(std::string(contentSize, 'x'));
+
+        return chat;
+    }
+
+    double toMegabytesPerSecond(size_t bytes, double seconds)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds;
+    }
+
+    void benchSerialize(const proto::S2C_Chat& chat, const BenchConfig& config)
+    {
+        proto::MessageSerializer serializer;
+        const size_t messageSize = chat.ByteSizeLong();
+
+        size_t chunkSize = 0;
+        const double serializeNs = bench::measureNs(
+            config.messageCount, 1,
+            [&]()
+            {
+                for (size_t i = 0; i < config.messageCount; ++i)
+                {
+                    chunkSize = serializer.serializeToSendBuffer(chat)->getWrittenSize();
+                }
+            });
+
+        const size_t packetCount = 1 + (messageSize - std::min(messageSize, net::FirstFragmentDataSize) + net::FragmentDataSize - 1) / net::FragmentDataSize;
+
+        spdlog::info("[JumboBench] serialize {} KB: {:.1f} us/msg, {:.0f} MB/s ({} packets, {} bytes on the wire)",
+            messageSize / 1024, serializeNs / 1000.0, toMegabytesPerSecond(messageSize, serializeNs / 1e9), packetCount, chunkSize);
+    }
+
+    // 127.0.0.1 TCP로 연결한 송신 세션과 수신 세션 (서로 다른 IO 스레드에서 실행)
+    class SessionPair
+    {
+    public:
+        SessionPair(size_t expectedSize, size_t windowSize)
+            : m_ioThreadPool(2, net::IoThreadModel::ContextPerThread)
+            , m_expectedSize(expectedSize)
+        {
+            asio::ip::tcp::acceptor acceptor(m_ioThreadPool.getThreadContext(0), asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+            asio::ip::tcp::socket senderSocket(m_ioThreadPool.getThreadContext(0));
+            senderSocket.connect(acceptor.local_endpoint());
+
+            asio::ip::tcp::socket receiverSocket(m_ioThreadPool.getThreadContext(1));
+            acceptor.accept(receiverSocket);
+
+            m_sender = net::Session::createInstance(std::move(senderSocket), m_eventQueue, net::IoThreadModel::ContextPerThread);
+            m_receiver = net::Session::createInstance(std::move(receiverSocket), m_eventQueue, net::IoThreadModel::ContextPerThread);
+
+            // 보내는 중인 메시지가 모두 송신 큐에 들어가도록 한도를 올린다 (기본 hardLimit보다 큰 메시지는 연결을 끊는다)
+            net::SendQueueConfig sendQueueConfig;
+            sendQueueConfig.highWatermark = std::max(sendQueueConfig.highWatermark, (windowSize + 1) * expectedSize);
+            sendQueueConfig.lowWatermark = std::min(sendQueueConfig.lowWatermark, sendQueueConfig.highWatermark);
+            sendQueueConfig.hardLimit = std::max(sendQueueConfig.hardLimit, 2 * sendQueueConfig.highWatermark);
+            m_sender->setSendQueueConfig(sendQueueConfig);
+
+            m_sender->start();
+            m_receiver->start();
+            m_ioThreadPool.run();
+        }
+
+        ~SessionPair()
+        {
+            m_sender->stop();
+            m_receiver->stop();
+
+            const auto deadline = bench::Clock::now() + 5s;
+            while ((m_closedCount < 2) && (bench::Clock::now() < deadline))
+            {
+                processEvents();
+                std::this_thread::sleep_for(1ms);
+            }
+
+            m_sender.reset();
+            m_receiver.reset();
+            m_ioThreadPool.reset();
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+        // 메인 스레드에서 직렬화해 보내고 받은 조각을 재조립하며, 받는 쪽에 도착하지 않은 메시지를 windowSize개 이하로 유지
+        // 어느 한 세션이 닫히면 (한도를 넘었으면) 중단
+        void transfer(proto::MessageSerializer& serializer, const proto::S2C_Chat& chat, size_t messageCount, size_t windowSize)
+        {
+            const uint64_t target = m_sentCount + messageCount;
+            while (m_sentCount < target)
+            {
+                if (!isConnected())
+                {
+                    return;
+                }
+
+                if (m_sentCount - m_receivedCount < windowSize)
+                {
+                    m_sender->send(serializer.serializeToSendBuffer(chat));
+                    ++m_sentCount;
+                    continue;
+                }
+
+                processEvents();
+                std::this_thread::yield();
+            }
+
+            while ((m_receivedCount < target) && isConnected())
+            {
+                processEvents();
+                std::this_thread::yield();
+            }
+        }
+
+        bool isConnected() const { return m_sender->isRunning() && m_receiver->isRunning(); }
+        uint64_t getCorruptCount() const { return m_corruptCount; }
+
+    private:
+        // WorldServer의 메인 스레드처럼 수신 이벤트마다 재조립한 메시지를 꺼내 크기만 확인
+        void processEvents()
+        {
+            net::SessionEventPtr event;
+            while (m_eventQueue.pop(event))
+            {
+                if (event->type == net::SessionEventType::Close)
+                {
+                    ++m_closedCount;
+                    continue;
+                }
+
+                if ((event->sessionId != m_receiver->getSessionId()) || !m_receiver->isRunning())
+                {
+                    continue;
+                }
+
+                net::PacketView packet;
+                while (m_receiver->getFrontPacket(packet))
+                {
+                    if (packet.payloadSize != m_expectedSize)
+                    {
+                        ++m_corruptCount;
+                    }
+
+                    m_receiver->popFrontPacket();
+                    ++m_receivedCount;
+                }
+
+                m_receiver->receive();
+            }
+        }
+
+    private:
+        net::IoThreadPool m_ioThreadPool;
+        net::SessionEventQueue m_eventQueue;
+        net::SessionPtr m_sender;
+        net::SessionPtr m_receiver;
+        size_t m_expectedSize = 0;
+        size_t m_closedCount = 0;
+        uint64_t m_sentCount = 0;
+        uint64_t m_receivedCount = 0;
+        uint64_t m_corruptCount = 0;
+    };
+
+    void benchTransfer(const proto::S2C_Chat& chat, const BenchConfig& config)
+    {
+        proto::MessageSerializer serializer;
+        const size_t messageSize = chat.ByteSizeLong();
+
+        SessionPair sessions(messageSize, config.windowSize);
+
+        // 준비 실행으로 재조립 버퍼와 송신 버퍼 블록을 데운다
+        sessions.transfer(serializer, chat, config.windowSize, config.windowSize);
+
+        const auto startTime = bench::Clock::now();
+
+        sessions.transfer(serializer, chat, config.messageCount, config.windowSize);
+
+        const double elapsed = std::chrono::duration<double>(bench::Clock::now() - startTime).count();
+
+        if (!sessions.isConnected() || (sessions.getCorruptCount() != 0))
+        {
+            spdlog::error("[JumboBench] 전송 실패 (연결 {}, 크기가 다른 메시지 {}개)", sessions.isConnected(), sessions.getCorruptCount());
+            return;
+        }
+
+        spdlog::info("[JumboBench] session to session {} KB: {:.0f} msg/s, {:.0f} MB/s (window {})",
+            messageSize / 1024, config.messageCount / elapsed, toMegabytesPerSecond(messageSize * config.messageCount, elapsed), config.windowSize);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    BenchConfig config;
+    config.messageSize = std::clamp<size_t>(bench::getArgument(argc, argv, 1, config.messageSize / 1024) * 1024, net::MaxPacketSize, net::MaxMessageSize);
+    config.messageCount = std::max<size_t>(bench::getArgument(argc, argv, 2, config.messageCount), 1);
+    config.windowSize = std::max<size_t>(bench::getArgument(argc, argv, 3, config.windowSize), 1);
+
+    const proto::S2C_Chat chat = makeChat(config.messageSize);
+
+    benchSerialize(chat, config);
+    benchTransfer(chat, config);
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
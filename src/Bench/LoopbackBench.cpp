@@ -0,0 +1,190 @@
+﻿#include "Core/Context.h"
+#include "Server.h"
+#include "Network/Event.h"
+#include "Protocol/Serializer.h"
+#include <cstdlib>
+#include <unordered_map>
+
+// 같은 프로세스의 WorldServer에 LoopbackTransport로 접속한 클라이언트들이 메시지를 보내고 응답을 모두 받을 때까지의 처리량 측정
+// 커널을 거치지 않으므로 세션 이후 파이프라인(이벤트 큐, 메시지 큐, 디스패처, 직렬화)의 비용만 남는다
+//
+// 사용법: LoopbackBench [클라이언트 수=50] [클라이언트당 메시지 수=20] [채팅 본문 크기=32, 0이면 하트비트]
+// 채팅은 모든 클라이언트에 브로드캐스트되므로 클라이언트 수의 제곱에 비례하는 응답을 받는다
+namespace
+{
+    struct BenchConfig
+    {
+        size_t clientCount = 50;
+        size_t messageCount = 20;
+        size_t bodySize = 32;
+    };
+
+    BenchConfig parseArguments(int argc, char* argv[])
+    {
+        BenchConfig config;
+        if (1 < argc)
+        {
+            config.clientCount = std::strtoul(argv[1], nullptr, 10);
+        }
+        if (2 < argc)
+        {
+            config.messageCount = std::strtoul(argv[2], nullptr, 10);
+        }
+        if (3 < argc)
+        {
+            config.bodySize = std::strtoul(argv[3], nullptr, 10);
+        }
+
+        return config;
+    }
+
+    void sendMessages(const BenchConfig& config, const std::vector<net::SessionPtr>& clients)
+    {
+        proto::MessageSerializer serializer;
+
+        for (size_t i = 0; i < config.messageCount; ++i)
+        {
+            for (const net::SessionPtr& client : clients)
+            {
+                if (config.bodySize == 0)
+                {
+                    proto::C2S_Heartbeat heartbeat;
+                    heartbeat.set_client_sent_at_ms(static_cast<int64_t>(i));
+                    client->send(serializer.serializeToSendBuffer(heartbeat));
+                    continue;
+                }
+
+                proto::C2S_Chat chat;
+                chat.set_content(std::string(config.bodySize, 'x'));
+                chat.set_client_message_id(i);
+                client->send(serializer.serializeToSendBuffer(chat));
+            }
+        }
+    }
+
+    // 응답 패킷 수를 세고 다음 수신을 시작
+    size_t receiveReplies(net::SessionEventQueue& eventQueue, std::unordered_map<net::SessionId, net::SessionPtr>& clients)
+    {
+        size_t replyCount = 0;
+
+        net::SessionEventPtr event;
+        while (eventQueue.pop(event))
+        {
+            if (event->type != net::SessionEventType::Receive)
+            {
+                continue;
+            }
+
+            const net::SessionPtr& client = clients[event->sessionId];
+
+            net::PacketView packet;
+            while (client->getFrontPacket(packet))
+            {
+                const auto messageType = static_cast<proto::MessageType>(packet.id);
+                if ((messageType == proto::MessageType::S2C_Chat) || (messageType == proto::MessageType::S2C_Heartbeat))
+                {
+                    ++replyCount;
+                }
+
+                client->popFrontPacket();
+            }
+
+            client->receive();
+        }
+
+        return replyCount;
+    }
+
+    void waitForClose(net::SessionEventQueue& eventQueue, size_t clientCount)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        size_t closedCount = 0;
+
+        while ((closedCount < clientCount) && (std::chrono::steady_clock::now() < deadline))
+        {
+            net::SessionEventPtr event;
+            while (eventQueue.pop(event))
+            {
+                if (event->type == net::SessionEventType::Close)
+                {
+                    ++closedCount;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    const BenchConfig config = parseArguments(argc, argv);
+
+    {
+        WorldServer server;
+        server.start();
+
+        asio::io_context clientContext;
+        auto workGuard = asio::make_work_guard(clientContext);
+        std::thread clientThread(
+            [&clientContext]()
+            {
+                clientContext.run();
+            });
+
+        net::SessionEventQueue eventQueue;
+        std::vector<net::SessionPtr> clients;
+        std::unordered_map<net::SessionId, net::SessionPtr> clientsById;
+        for (size_t i = 0; i < config.clientCount; ++i)
+        {
+            net::SessionPtr client = net::Session::createInstance(server.connectLoopback(clientContext), eventQueue);
+            client->start();
+            clients.push_back(client);
+            clientsById[client->getSessionId()] = client;
+        }
+
+        // 서버가 메인 루프에서 수락 이벤트를 처리할 때까지 대기
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        const size_t expectedCount = (config.bodySize == 0)
+            ? config.clientCount * config.messageCount
+            : config.clientCount * config.clientCount * config.messageCount;
+
+        const auto startTime = std::chrono::steady_clock::now();
+        sendMessages(config, clients);
+
+        size_t receivedCount = 0;
+        while ((receivedCount < expectedCount) && (std::chrono::steady_clock::now() - startTime < std::chrono::seconds(20)))
+        {
+            receivedCount += receiveReplies(eventQueue, clientsById);
+            std::this_thread::yield();
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        spdlog::info("[LoopbackBench] 클라이언트 {}개 x 메시지 {}개 (본문 {} bytes): 응답 {}/{}개, {:.3f}초, 초당 {:.0f}개",
+            config.clientCount, config.messageCount, config.bodySize,
+            receivedCount, expectedCount, elapsed, receivedCount / elapsed);
+
+        for (const net::SessionPtr& client : clients)
+        {
+            client->stop();
+        }
+        waitForClose(eventQueue, clients.size());
+
+        clientsById.clear();
+        clients.clear();
+
+        server.stop();
+        workGuard.reset();
+        clientContext.stop();
+        clientThread.join();
+        server.join();
+    }
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
@@ -0,0 +1,4 @@
+﻿#pragma once
+
+#include "Core/Pch.h"
+#include "Network/Pch.h"
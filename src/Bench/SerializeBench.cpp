@@ -0,0 +1,148 @@
+﻿#include "Bench.h"
+#include "Protocol/Serializer.h"
+#include "Network/Compression.h"
+#include <thread>
+
+// 송신 메시지 직렬화 비용
+// - 압축: 채팅 페이로드 크기별 LZ4/zstd 압축률과 압축/해제 시간
+// - 스레드: 스레드마다 자기 SendBufferManager로 동시에 직렬화할 때의 전체 처리량 (1 ~ 16 스레드)
+//
+// 사용법: SerializeBench [반복 배수=1]
+namespace
+{
+    proto::S2C_Chat makeChat(size_t messageSize)
+    {
+        proto::S2C_Chat chat;
+        chat.set_sender_name("player-12");
+        chat.set_server_message_id(12345);
+        chat.set_server_sent_at_ms(1700000000000);
+        chat.set_client_message_id(7);
+        chat.set_sender_session_id(3);
+
+        // 나머지 필드를 뺀 만큼 본문으로 채워 직렬화 크기를 messageSize에 맞춘다
+        const size_t fieldsSize = chat.ByteSizeLong();
+        const size_t contentSize = (messageSize > fieldsSize + 4) ? messageSize - fieldsSize - 4 : 0;
+        chat.set_content(std::string(contentSize, 'x'));
+
+        return chat;
+    }
+
+    // 같은 말이 반복되는 채팅처럼 압축되는 본문
+    std::string makeChatText(size_t size)
+    {
+        static const char* const Words[] = { "hello", "party", "dungeon", "raid", "anyone", "lfg", "heal", "tank", "boss", "loot", "gg", "thanks" };
+
+        std::string text;
+        uint32_t seed = 12345;
+        while (text.size() < size)
+        {
+            seed = seed * 1103515245 + 12345;
+            text += Words[(seed >> 16) % std::size(Words)];
+            text += ' ';
+        }
+        text.resize(size);
+
+        return text;
+    }
+
+    void benchCompression(size_t scale)
+    {
+        for (size_t contentSize : { 64, 256, 1024, 4096, 16384 })
+        {
+            proto::S2C_Chat chat = makeChat(0);
+            chat.set_content(makeChatText(contentSize));
+            const std::string payload = chat.SerializeAsString();
+            const size_t count = ((contentSize < 4096) ? 100000 : 20000) * scale;
+
+            for (net::CompressionCodec codec : { net::CompressionCodec::Lz4, net::CompressionCodec::Zstd })
+            {
+                std::vector<uint8_t> compressed(net::PacketCompressor::getCompressBound(codec, payload.size()));
+                std::vector<uint8_t> decompressed(payload.size());
+                const auto* source = reinterpret_cast<const uint8_t*>(payload.data());
+
+                size_t compressedSize = 0;
+                const double compressNs = bench::measureNs(
+                    count, 1,
+                    [&]()
+                    {
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            compressedSize = net::PacketCompressor::compress(codec, source, payload.size(), compressed.data(), compressed.size());
+                        }
+                    });
+
+                bool intact = true;
+                const double decompressNs = bench::measureNs(
+                    count, 1,
+                    [&]()
+                    {
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            intact &= net::PacketCompressor::decompress(codec, compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+                        }
+                    });
+
+                intact &= (std::memcmp(decompressed.data(), payload.data(), payload.size()) == 0);
+
+                // 압축 패킷은 원래 패킷 헤더 뒤에 압축 헤더가 붙는다
+                const size_t plainWireSize = sizeof(net::PacketHeader) + payload.size();
+                const size_t compressedWireSize = sizeof(net::PacketHeader) + sizeof(net::CompressionHeader) + compressedSize;
+
+                spdlog::info("[SerializeBench] compress {} bytes with {}: wire {} -> {} bytes ({:.0f}%), compress {:.0f} ns, decompress {:.0f} ns{}",
+                    payload.size(), (codec == net::CompressionCodec::Lz4) ? "lz4 " : "zstd",
+                    plainWireSize, compressedWireSize, 100.0 * compressedWireSize / plainWireSize,
+                    compressNs, decompressNs, intact ? "" : " (MISMATCH)");
+            }
+        }
+    }
+
+    // 스레드마다 자기 송신 버퍼 관리자에서 청크를 열고 해제 (다른 스레드와 공유하는 상태 없음)
+    void benchThreads(size_t scale)
+    {
+        const proto::S2C_Chat chat = makeChat(128);
+        const size_t countPerThread = 500000 * scale;
+
+        for (size_t threadCount : { 1, 2, 4, 8, 16 })
+        {
+            std::vector<std::thread> threads;
+            const auto startTime = bench::Clock::now();
+
+            std::vector<uint64_t> writtenSizes(threadCount);
+            for (size_t t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back(
+                    [&chat, countPerThread, &writtenSize = writtenSizes[t]]()
+                    {
+                        // 결과는 끝날 때 한 번만 기록 (스레드끼리 같은 캐시 라인에 쓰지 않도록)
+                        proto::MessageSerializer serializer;
+                        uint64_t localSize = 0;
+                        for (size_t i = 0; i < countPerThread; ++i)
+                        {
+                            localSize += serializer.serializeToSendBuffer(chat)->getWrittenSize();
+                        }
+                        writtenSize = localSize;
+                    });
+            }
+
+            for (size_t t = 0; t < threadCount; ++t)
+            {
+                threads[t].join();
+                bench::consume(writtenSizes[t]);
+            }
+
+            const double elapsed = std::chrono::duration<double>(bench::Clock::now() - startTime).count();
+            spdlog::info("[SerializeBench] {:>2} threads: {:.1f} M msg/s ({} bytes S2C_Chat)",
+                threadCount, countPerThread * threadCount / elapsed / 1e6, chat.ByteSizeLong());
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t scale = std::max<size_t>(bench::getArgument(argc, argv, 1, 1), 1);
+
+    benchCompression(scale);
+    benchThreads(scale);
+
+    return 0;
+}
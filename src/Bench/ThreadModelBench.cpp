@@ -0,0 +1,381 @@
+﻿#include "Bench.h"
+#include "Core/Context.h"
+#include "Network/Service.h"
+#include "Network/Event.h"
+#include "Network/Packet.h"
+#include <algorithm>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif // __linux__
+
+// 같은 에코 서버를 IO 스레드 모델만 바꿔 돌렸을 때의 처리량과 왕복 지연 시간(p50, p99) 비교
+// - SharedContext: 모든 IO 스레드가 io_context 하나를 공유하고 세션은 strand로 직렬화
+// - ContextPerThread: 스레드마다 io_context를 두고 세션은 배정된 스레드에서만 실행
+//
+// 사용법: ThreadModelBench [연결 수=200] [측정 시간(초)=3] [페이로드 크기=64] [IO 스레드 수=4]
+#if defined(__linux__)
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint16_t BenchPort = 12349;
+    constexpr net::PacketId EchoPacketId = 1;
+
+    struct BenchConfig
+    {
+        size_t connectionCount = 200;
+        size_t seconds = 3;
+        size_t payloadSize = 64;
+        size_t threadCount = 4;
+    };
+
+    // 받은 패킷을 이벤트 스레드에서 돌려보내는 서버 (WorldServer처럼 수신 이벤트를 한 스레드에서 처리)
+    class EchoServer
+    {
+    public:
+        EchoServer(net::IoThreadModel threadModel, size_t threadCount)
+            : m_ioThreadPool(threadCount, threadModel)
+        {
+            m_service = net::ServerService::createInstance(
+                m_ioThreadPool, m_serviceEventQueue, BenchPort,
+                [this](net::SessionTransportPtr&& transport)
+                {
+                    return net::Session::createInstance(std::move(transport), m_sessionEventQueue, m_ioThreadPool.getThreadModel());
+                });
+            m_service->setTransportBackend(net::TransportBackend::Socket);
+        }
+
+        void start()
+        {
+            m_running = true;
+            m_ioThreadPool.run();
+            m_service->start();
+
+            m_eventThread = std::thread(
+                [this]()
+                {
+                    while (m_running.load())
+                    {
+                        processEvents();
+                        std::this_thread::sleep_for(1ms);
+                    }
+                });
+        }
+
+        void stop()
+        {
+            m_running = false;
+            m_eventThread.join();
+
+            for (auto& [sessionId, session] : m_sessions)
+            {
+                session->stop();
+            }
+
+            m_service->stop();
+
+            // 세션과 서비스가 닫힐 때까지 기다린 뒤 IO 스레드 종료 (닫히기 전에 멈추면 리스닝 소켓이 남는다)
+            const auto deadline = bench::Clock::now() + 5s;
+            while ((!m_sessions.empty() || !m_serviceClosed) && (bench::Clock::now() < deadline))
+            {
+                processEvents();
+                std::this_thread::sleep_for(1ms);
+            }
+
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+        size_t getStartedCount() const { return m_startedCount.load(); }
+
+    private:
+        static void echo(const net::SessionPtr& session)
+        {
+            net::PacketView packet;
+            while (session->getFrontPacket(packet))
+            {
+                const size_t totalSize = sizeof(net::PacketHeader) + packet.payloadSize;
+                net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+                auto* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+                header->size = static_cast<net::PacketSize>(totalSize);
+                header->id = packet.id;
+                std::memcpy(header + 1, packet.payload, packet.payloadSize);
+
+                chunk->onWritten(totalSize);
+                chunk->close();
+
+                session->send(chunk);
+                session->popFrontPacket();
+            }
+
+            session->receive();
+        }
+
+        void processEvents()
+        {
+            net::ServiceEventPtr serviceEvent;
+            while (m_serviceEventQueue.pop(serviceEvent))
+            {
+                if (serviceEvent->type == net::ServiceEventType::Close)
+                {
+                    m_serviceClosed = true;
+                    continue;
+                }
+
+                if (serviceEvent->type != net::ServiceEventType::Accept)
+                {
+                    continue;
+                }
+
+                const net::SessionPtr& session = static_cast<net::ServiceAcceptEvent*>(serviceEvent.get())->session;
+                m_sessions[session->getSessionId()] = session;
+                session->start();
+                m_startedCount.fetch_add(1);
+            }
+
+            net::SessionEventPtr sessionEvent;
+            while (m_sessionEventQueue.pop(sessionEvent))
+            {
+                auto it = m_sessions.find(sessionEvent->sessionId);
+                if (it == m_sessions.end())
+                {
+                    continue;
+                }
+
+                if (sessionEvent->type == net::SessionEventType::Receive)
+                {
+                    echo(it->second);
+                }
+                else if (sessionEvent->type == net::SessionEventType::Close)
+                {
+                    m_ioThreadPool.releaseSessionContext(asio::query(it->second->getExecutor(), asio::execution::context));
+                    m_sessions.erase(it);
+                }
+            }
+        }
+
+    private:
+        std::atomic<bool> m_running = false;
+        std::atomic<size_t> m_startedCount = 0;
+        bool m_serviceClosed = false;
+        net::IoThreadPool m_ioThreadPool;
+        net::ServiceEventQueue m_serviceEventQueue;
+        net::SessionEventQueue m_sessionEventQueue;
+        net::ServerServicePtr m_service;
+        std::unordered_map<net::SessionId, net::SessionPtr> m_sessions; // 이벤트 스레드에서만 사용
+        std::thread m_eventThread;
+    };
+
+    // 연결마다 패킷 하나를 보내고 응답을 다 받으면 다시 보내는 논블로킹 클라이언트 (왕복마다 보낸 시각부터 응답을 다 받은 시각까지 기록)
+    class PingClient
+    {
+    public:
+        explicit PingClient(const BenchConfig& config)
+            : m_packetSize(sizeof(net::PacketHeader) + config.payloadSize)
+            , m_request(m_packetSize, 0x5A)
+            , m_connections(config.connectionCount)
+        {
+            auto* header = reinterpret_cast<net::PacketHeader*>(m_request.data());
+            header->size = static_cast<net::PacketSize>(m_packetSize);
+            header->id = EchoPacketId;
+        }
+
+        ~PingClient()
+        {
+            for (Connection& connection : m_connections)
+            {
+                if (connection.fd >= 0)
+                {
+                    ::close(connection.fd);
+                }
+            }
+
+            if (m_epollFd >= 0)
+            {
+                ::close(m_epollFd);
+            }
+        }
+
+        // 모든 연결을 블로킹으로 맺은 뒤 논블로킹으로 바꾼다
+        bool connect()
+        {
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(BenchPort);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            m_epollFd = ::epoll_create1(0);
+            for (size_t i = 0; i < m_connections.size(); ++i)
+            {
+                const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+                if ((fd < 0) || (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0))
+                {
+                    spdlog::error("[ThreadModelBench] 연결 실패: {} ({})", i, std::strerror(errno));
+                    if (fd >= 0)
+                    {
+                        ::close(fd);
+                    }
+                    return false;
+                }
+
+                const int noDelay = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+                epoll_event event = {};
+                event.events = EPOLLIN;
+                event.data.u64 = i;
+                ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+
+                m_connections[i].fd = fd;
+            }
+
+            return true;
+        }
+
+        // 연결마다 첫 요청을 보낸다 (이후로는 응답을 받을 때마다 다음 요청을 보내므로 연결마다 항상 하나가 진행 중)
+        void start()
+        {
+            for (Connection& connection : m_connections)
+            {
+                sendRequest(connection);
+            }
+        }
+
+        // duration 동안 왕복을 반복하고 완료한 왕복마다의 지연 시간(ns) 반환
+        std::vector<uint64_t> run(std::chrono::nanoseconds duration)
+        {
+            std::vector<uint64_t> latencies;
+            std::vector<epoll_event> events(1024);
+            std::vector<uint8_t> buffer(64 * 1024);
+
+            const auto deadline = bench::Clock::now() + duration;
+            while (bench::Clock::now() < deadline)
+            {
+                const int eventCount = ::epoll_wait(m_epollFd, events.data(), static_cast<int>(events.size()), 10);
+                const auto now = bench::Clock::now();
+                for (int i = 0; i < eventCount; ++i)
+                {
+                    Connection& connection = m_connections[events[i].data.u64];
+
+                    const ssize_t bytesRead = ::recv(connection.fd, buffer.data(), buffer.size(), 0);
+                    if (bytesRead <= 0)
+                    {
+                        continue;
+                    }
+
+                    connection.receivedBytes += static_cast<size_t>(bytesRead);
+                    if (connection.receivedBytes >= m_packetSize)
+                    {
+                        connection.receivedBytes -= m_packetSize;
+                        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - connection.sentTime).count());
+                        sendRequest(connection);
+                    }
+                }
+            }
+
+            return latencies;
+        }
+
+    private:
+        struct Connection
+        {
+            int fd = -1;
+            size_t receivedBytes = 0;
+            bench::Clock::time_point sentTime;
+        };
+
+        void sendRequest(Connection& connection)
+        {
+            // 작은 패킷 하나는 빈 소켓 버퍼에 한 번에 들어간다
+            connection.sentTime = bench::Clock::now();
+            [[maybe_unused]] const ssize_t bytesWritten = ::send(connection.fd, m_request.data(), m_request.size(), MSG_NOSIGNAL);
+        }
+
+    private:
+        const size_t m_packetSize;
+        std::vector<uint8_t> m_request;
+        std::vector<Connection> m_connections;
+        int m_epollFd = -1;
+    };
+
+    // 정렬된 지연 시간에서 백분위 값(us)
+    double getPercentileUs(const std::vector<uint64_t>& sortedLatencies, double percentile)
+    {
+        if (sortedLatencies.empty())
+        {
+            return 0.0;
+        }
+
+        const size_t index = std::min(static_cast<size_t>(percentile * sortedLatencies.size()), sortedLatencies.size() - 1);
+        return sortedLatencies[index] / 1000.0;
+    }
+
+    void runThreadModel(net::IoThreadModel threadModel, const BenchConfig& config)
+    {
+        const char* modelName = (threadModel == net::IoThreadModel::SharedContext) ? "SharedContext   " : "ContextPerThread";
+
+        EchoServer server(threadModel, config.threadCount);
+        server.start();
+
+        // 클라이언트 연결은 서버를 멈춘 뒤에 닫는다 (먼저 닫으면 세션을 멈출 때 끊긴 소켓 오류가 쏟아진다)
+        PingClient client(config);
+        if (client.connect())
+        {
+            // 모든 세션이 시작된 뒤, 준비 실행으로 세션의 버퍼를 데운다
+            const auto deadline = bench::Clock::now() + 10s;
+            while ((server.getStartedCount() < config.connectionCount) && (bench::Clock::now() < deadline))
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+
+            client.start();
+            client.run(500ms);
+
+            const auto startTime = bench::Clock::now();
+            std::vector<uint64_t> latencies = client.run(std::chrono::seconds(config.seconds));
+            const double elapsed = std::chrono::duration<double>(bench::Clock::now() - startTime).count();
+
+            std::sort(latencies.begin(), latencies.end());
+
+            spdlog::info("[ThreadModelBench] {}: {} connections, {} IO threads, {:.0f} round trips/s, p50 {:.1f} us, p99 {:.1f} us",
+                modelName, config.connectionCount, config.threadCount, latencies.size() / elapsed,
+                getPercentileUs(latencies, 0.50), getPercentileUs(latencies, 0.99));
+        }
+
+        server.stop();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    BenchConfig config;
+    config.connectionCount = std::max<size_t>(bench::getArgument(argc, argv, 1, config.connectionCount), 1);
+    config.seconds = std::max<size_t>(bench::getArgument(argc, argv, 2, config.seconds), 1);
+    config.payloadSize = std::min(bench::getArgument(argc, argv, 3, config.payloadSize), net::ReceiveBuffer::DefaultSize - sizeof(net::PacketHeader));
+    config.threadCount = std::max<size_t>(bench::getArgument(argc, argv, 4, config.threadCount), 1);
+
+    runThreadModel(net::IoThreadModel::SharedContext, config);
+    runThreadModel(net::IoThreadModel::ContextPerThread, config);
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
+#else
+int main()
+{
+    spdlog::error("[ThreadModelBench] Linux에서만 실행할 수 있다");
+    return 0;
+}
+#endif // __linux__
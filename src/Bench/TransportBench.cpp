@@ -0,0 +1,280 @@
+﻿#include "Bench.h"
+#include "Core/Context.h"
+#include "Network/Service.h"
+#include "Network/Event.h"
+#include "Network/Packet.h"
+#include <algorithm>
+#include <unordered_map>
+
+// 같은 호스트에서 TCP 루프백과 유닉스 도메인 소켓으로 ServerService에 접속해 패킷 형식 그대로 주고받을 때의 지연 시간과 처리량 비교
+// 서버는 이벤트 스레드가 받은 패킷을 파싱 없이 그대로 돌려보내므로 메인 루프의 틱이나 메시지 처리 비용은 들어가지 않는다 (수신 이벤트를 넘기는 비용은 포함)
+//
+// 사용법: TransportBench [왕복 횟수=20000] [처리량 측정 패킷 수=200000] [페이로드 크기=1024] [한 번에 보내는 패킷 수=64]
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint16_t BenchPort = 12346;
+    constexpr net::PacketId EchoPacketId = 1;
+    constexpr size_t LatencyPayloadSize = 16; // 하트비트 응답 크기
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+    constexpr const char* BenchSocketPath = "/tmp/byteborne-bench.sock";
+#endif // ASIO_HAS_LOCAL_SOCKETS
+
+    struct BenchConfig
+    {
+        size_t roundTripCount = 20000;
+        size_t packetCount = 200000;
+        size_t payloadSize = 1024;
+        size_t windowSize = 64;
+    };
+
+    // 받은 패킷을 이벤트 스레드에서 바로 돌려보내는 서버
+    class EchoServer
+    {
+    public:
+        EchoServer()
+            : m_ioThreadPool(2, net::IoThreadModel::ContextPerThread)
+        {
+            auto sessionFactory = [this](net::SessionTransportPtr&& transport)
+            {
+                return createSession(std::move(transport));
+            };
+
+            m_tcpService = net::ServerService::createInstance(m_ioThreadPool, m_serviceEventQueue, BenchPort, sessionFactory);
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+            m_localService = net::ServerService::createInstance(m_ioThreadPool, m_serviceEventQueue, BenchSocketPath, sessionFactory);
+#endif // ASIO_HAS_LOCAL_SOCKETS
+        }
+
+        void start()
+        {
+            m_running = true;
+            m_ioThreadPool.run();
+
+            m_tcpService->start();
+            if (m_localService)
+            {
+                m_localService->start();
+            }
+
+            m_eventThread = std::thread(
+                [this]()
+                {
+                    while (m_running.load())
+                    {
+                        // 왕복 지연에 잠든 시간이 섞이지 않도록 쉬지 않고 이벤트를 처리한다
+                        processEvents();
+                        std::this_thread::yield();
+                    }
+                });
+        }
+
+        void stop()
+        {
+            m_running = false;
+            m_eventThread.join();
+
+            for (auto& [sessionId, session] : m_sessions)
+            {
+                session->stop();
+            }
+
+            m_tcpService->stop();
+            if (m_localService)
+            {
+                m_localService->stop();
+            }
+
+            // 세션이 닫힐 때까지 기다린 뒤 IO 스레드 종료
+            const auto deadline = bench::Clock::now() + 1s;
+            while (!m_sessions.empty() && (bench::Clock::now() < deadline))
+            {
+                processEvents();
+                std::this_thread::sleep_for(1ms);
+            }
+
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+    private:
+        net::SessionPtr createSession(net::SessionTransportPtr&& transport)
+        {
+            return net::Session::createInstance(std::move(transport), m_sessionEventQueue, m_ioThreadPool.getThreadModel());
+        }
+
+        static void echo(const net::SessionPtr& session)
+        {
+            net::PacketView packet;
+            while (session->getFrontPacket(packet))
+            {
+                const size_t totalSize = sizeof(net::PacketHeader) + packet.payloadSize;
+                net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+                auto* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+                header->size = static_cast<net::PacketSize>(totalSize);
+                header->id = packet.id;
+                std::memcpy(header + 1, packet.payload, packet.payloadSize);
+
+                chunk->onWritten(totalSize);
+                chunk->close();
+
+                session->dispatchSend(chunk);
+                session->popFrontPacket();
+            }
+
+            session->receive();
+        }
+
+        void processEvents()
+        {
+            net::ServiceEventPtr serviceEvent;
+            while (m_serviceEventQueue.pop(serviceEvent))
+            {
+                if (serviceEvent->type != net::ServiceEventType::Accept)
+                {
+                    continue;
+                }
+
+                const net::SessionPtr& session = static_cast<net::ServiceAcceptEvent*>(serviceEvent.get())->session;
+                m_sessions[session->getSessionId()] = session;
+                session->start();
+            }
+
+            net::SessionEventPtr sessionEvent;
+            while (m_sessionEventQueue.pop(sessionEvent))
+            {
+                auto it = m_sessions.find(sessionEvent->sessionId);
+                if (it == m_sessions.end())
+                {
+                    continue;
+                }
+
+                if (sessionEvent->type == net::SessionEventType::Receive)
+                {
+                    if (it->second->isRunning())
+                    {
+                        echo(it->second);
+                    }
+                }
+                else if (sessionEvent->type == net::SessionEventType::Close)
+                {
+                    // 서비스가 수락하면서 반영한 io_context의 부하를 되돌린다
+                    m_ioThreadPool.releaseSessionContext(asio::query(it->second->getExecutor(), asio::execution::context));
+                    m_sessions.erase(it);
+                }
+            }
+        }
+
+    private:
+        std::atomic<bool> m_running = false;
+        net::IoThreadPool m_ioThreadPool;
+        net::ServiceEventQueue m_serviceEventQueue;
+        net::SessionEventQueue m_sessionEventQueue;
+        net::ServerServicePtr m_tcpService;
+        net::ServerServicePtr m_localService;
+        std::unordered_map<net::SessionId, net::SessionPtr> m_sessions; // 이벤트 스레드에서만 사용
+        std::thread m_eventThread;
+    };
+
+    // payloadSize 바이트 페이로드의 패킷을 count개 이어 붙인 버퍼
+    std::vector<uint8_t> makePackets(size_t payloadSize, size_t count)
+    {
+        const size_t packetSize = sizeof(net::PacketHeader) + payloadSize;
+        std::vector<uint8_t> packets(packetSize * count, 0x5A);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto* header = reinterpret_cast<net::PacketHeader*>(packets.data() + i * packetSize);
+            header->size = static_cast<net::PacketSize>(packetSize);
+            header->id = EchoPacketId;
+        }
+
+        return packets;
+    }
+
+    // 블로킹 소켓 클라이언트로 패킷 하나씩 왕복한 지연 시간과, windowSize개씩 보내고 받은 처리량 측정
+    // 한 번에 보내는 양은 소켓 버퍼보다 작아야 한다 (다 쓰기 전에는 응답을 읽지 않으므로)
+    template<typename TSocket>
+    void runClient(const char* transportName, TSocket& socket, const BenchConfig& config)
+    {
+        const std::vector<uint8_t> request = makePackets(LatencyPayloadSize, 1);
+        std::vector<uint8_t> reply(request.size());
+
+        std::vector<double> latencies;
+        latencies.reserve(config.roundTripCount);
+
+        for (size_t i = 0; i < config.roundTripCount; ++i)
+        {
+            const auto startTime = bench::Clock::now();
+            asio::write(socket, asio::buffer(request));
+            asio::read(socket, asio::buffer(reply));
+            latencies.push_back(std::chrono::duration<double, std::micro>(bench::Clock::now() - startTime).count());
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        double latencySum = 0.0;
+        for (double latency : latencies)
+        {
+            latencySum += latency;
+        }
+
+        const std::vector<uint8_t> window = makePackets(config.payloadSize, config.windowSize);
+        std::vector<uint8_t> windowReply(window.size());
+
+        const size_t windowCount = std::max<size_t>(config.packetCount / config.windowSize, 1);
+        const auto startTime = bench::Clock::now();
+        for (size_t i = 0; i < windowCount; ++i)
+        {
+            asio::write(socket, asio::buffer(window));
+            asio::read(socket, asio::buffer(windowReply));
+        }
+        const double elapsed = std::chrono::duration<double>(bench::Clock::now() - startTime).count();
+
+        const size_t packetCount = windowCount * config.windowSize;
+        spdlog::info("[TransportBench] {}: round trip avg {:.1f} us, p50 {:.1f} us, p99 {:.1f} us ({} bytes)",
+            transportName, latencySum / latencies.size(), latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100], request.size());
+        spdlog::info("[TransportBench] {}: {:.0f} packets/s, {:.1f} MB/s ({} byte payload, {} per write)",
+            transportName, packetCount / elapsed, packetCount * config.payloadSize / elapsed / 1e6, config.payloadSize, config.windowSize);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    BenchConfig config;
+    config.roundTripCount = std::max<size_t>(bench::getArgument(argc, argv, 1, config.roundTripCount), 1);
+    config.packetCount = bench::getArgument(argc, argv, 2, config.packetCount);
+    config.payloadSize = std::min(bench::getArgument(argc, argv, 3, config.payloadSize), net::MaxPacketSize - sizeof(net::PacketHeader));
+    config.windowSize = std::max<size_t>(bench::getArgument(argc, argv, 4, config.windowSize), 1);
+
+    {
+        EchoServer server;
+        server.start();
+
+        asio::io_context ioContext;
+
+        asio::ip::tcp::socket tcpSocket(ioContext);
+        tcpSocket.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), BenchPort));
+        tcpSocket.set_option(asio::ip::tcp::no_delay(true));
+        runClient("TCP loopback", tcpSocket, config);
+        tcpSocket.close();
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+        asio::local::stream_protocol::socket localSocket(ioContext);
+        localSocket.connect(asio::local::stream_protocol::endpoint(BenchSocketPath));
+        runClient("Unix domain socket", localSocket, config);
+        localSocket.close();
+#endif // ASIO_HAS_LOCAL_SOCKETS
+
+        server.stop();
+    }
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
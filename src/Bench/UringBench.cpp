@@ -0,0 +1,546 @@
+﻿#include "Bench.h"
+#include "Core/Context.h"
+#include "Network/Service.h"
+#include "Network/Event.h"
+#include "Network/Packet.h"
+#include "Network/Uring.h"
+#include <algorithm>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+// 수천 개의 루프백 연결이 각자 패킷 하나씩 왕복할 때, socket(epoll) 백엔드와 io_uring 백엔드의 처리량과 메시지당 시스템 호출 수 비교
+// 서버 쪽 시스템 호출은 이 실행 파일에서 libc의 epoll_wait/read/write/recvmsg/sendmsg/accept4 등을 가로채 세고 (클라이언트 스레드는 제외),
+// io_uring_enter는 libc를 거치지 않으므로 UringService의 통계로 더한다
+//
+// 사용법: UringBench [연결 수=2000] [측정 시간(초)=3] [페이로드 크기=64] [IO 스레드 수=2]
+#if defined(__linux__)
+namespace
+{
+    enum SyscallKind
+    {
+        EpollWait,
+        Receive,    // read, readv, recv, recvmsg
+        Send,       // write, writev, send, sendmsg
+        Accept,
+        SyscallKindCount,
+    };
+
+    std::atomic<uint64_t> s_syscallCounts[SyscallKindCount] = {};
+    thread_local bool t_excluded = false;   // 클라이언트 스레드의 호출은 세지 않는다
+
+    void countSyscall(SyscallKind kind)
+    {
+        if (!t_excluded)
+        {
+            s_syscallCounts[kind].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename TFunction>
+    TFunction findNext(const char* name)
+    {
+        return reinterpret_cast<TFunction>(::dlsym(RTLD_NEXT, name));
+    }
+}
+
+// asio와 전송 계층이 호출하는 libc 함수를 가로채 센 뒤 원래 함수로 넘긴다
+extern "C"
+{
+    int epoll_wait(int epfd, epoll_event* events, int maxevents, int timeout)
+    {
+        static const auto next = findNext<int (*)(int, epoll_event*, int, int)>("epoll_wait");
+        countSyscall(EpollWait);
+        return next(epfd, events, maxevents, timeout);
+    }
+
+    ssize_t read(int fd, void* buffer, size_t size)
+    {
+        static const auto next = findNext<ssize_t (*)(int, void*, size_t)>("read");
+        countSyscall(Receive);
+        return next(fd, buffer, size);
+    }
+
+    ssize_t readv(int fd, const iovec* iov, int iovcnt)
+    {
+        static const auto next = findNext<ssize_t (*)(int, const iovec*, int)>("readv");
+        countSyscall(Receive);
+        return next(fd, iov, iovcnt);
+    }
+
+    ssize_t recv(int fd, void* buffer, size_t size, int flags)
+    {
+        static const auto next = findNext<ssize_t (*)(int, void*, size_t, int)>("recv");
+        countSyscall(Receive);
+        return next(fd, buffer, size, flags);
+    }
+
+    ssize_t recvmsg(int fd, msghdr* message, int flags)
+    {
+        static const auto next = findNext<ssize_t (*)(int, msghdr*, int)>("recvmsg");
+        countSyscall(Receive);
+        return next(fd, message, flags);
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t size)
+    {
+        static const auto next = findNext<ssize_t (*)(int, const void*, size_t)>("write");
+        countSyscall(Send);
+        return next(fd, buffer, size);
+    }
+
+    ssize_t writev(int fd, const iovec* iov, int iovcnt)
+    {
+        static const auto next = findNext<ssize_t (*)(int, const iovec*, int)>("writev");
+        countSyscall(Send);
+        return next(fd, iov, iovcnt);
+    }
+
+    ssize_t send(int fd, const void* buffer, size_t size, int flags)
+    {
+        static const auto next = findNext<ssize_t (*)(int, const void*, size_t, int)>("send");
+        countSyscall(Send);
+        return next(fd, buffer, size, flags);
+    }
+
+    ssize_t sendmsg(int fd, const msghdr* message, int flags)
+    {
+        static const auto next = findNext<ssize_t (*)(int, const msghdr*, int)>("sendmsg");
+        countSyscall(Send);
+        return next(fd, message, flags);
+    }
+
+    int accept4(int fd, sockaddr* address, socklen_t* length, int flags)
+    {
+        static const auto next = findNext<int (*)(int, sockaddr*, socklen_t*, int)>("accept4");
+        countSyscall(Accept);
+        return next(fd, address, length, flags);
+    }
+
+    int accept(int fd, sockaddr* address, socklen_t* length)
+    {
+        static const auto next = findNext<int (*)(int, sockaddr*, socklen_t*)>("accept");
+        countSyscall(Accept);
+        return next(fd, address, length);
+    }
+}
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint16_t BenchPort = 12348;
+    constexpr net::PacketId EchoPacketId = 1;
+
+    struct BenchConfig
+    {
+        size_t connectionCount = 2000;
+        size_t seconds = 3;
+        size_t payloadSize = 64;
+        size_t threadCount = 2;
+    };
+
+    struct SyscallSnapshot
+    {
+        uint64_t counts[SyscallKindCount] = {};
+        uint64_t enterCalls = 0;
+
+        uint64_t getTotal() const
+        {
+            uint64_t total = enterCalls;
+            for (uint64_t count : counts)
+            {
+                total += count;
+            }
+
+            return total;
+        }
+    };
+
+    // 받은 패킷을 이벤트 스레드에서 돌려보내는 서버 (ThreadModelBench와 같은 에코)
+    class EchoServer
+    {
+    public:
+        EchoServer(net::TransportBackend backend, size_t threadCount)
+            : m_ioThreadPool(threadCount, net::IoThreadModel::ContextPerThread)
+        {
+            m_service = net::ServerService::createInstance(
+                m_ioThreadPool, m_serviceEventQueue, BenchPort,
+                [this](net::SessionTransportPtr&& transport)
+                {
+                    return net::Session::createInstance(std::move(transport), m_sessionEventQueue, m_ioThreadPool.getThreadModel());
+                });
+            m_service->setTransportBackend(backend);
+        }
+
+        void start()
+        {
+            m_running = true;
+            m_ioThreadPool.run();
+            m_service->start();
+
+            m_eventThread = std::thread(
+                [this]()
+                {
+                    while (m_running.load())
+                    {
+                        processEvents();
+                        std::this_thread::sleep_for(1ms);
+                    }
+                });
+        }
+
+        void stop()
+        {
+            m_running = false;
+            m_eventThread.join();
+
+            for (auto& [sessionId, session] : m_sessions)
+            {
+                session->stop();
+            }
+
+            m_service->stop();
+
+            // 세션과 서비스가 닫힐 때까지 기다린 뒤 IO 스레드 종료 (닫히기 전에 멈추면 리스닝 소켓이 남는다)
+            const auto deadline = bench::Clock::now() + 5s;
+            while ((!m_sessions.empty() || !m_serviceClosed) && (bench::Clock::now() < deadline))
+            {
+                processEvents();
+                std::this_thread::sleep_for(1ms);
+            }
+
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+        size_t getStartedCount() const { return m_startedCount.load(); }
+
+        net::TransportBackend getBackend() const { return m_service->getTransportBackend(); }
+
+        SyscallSnapshot takeSnapshot()
+        {
+            SyscallSnapshot snapshot;
+            for (size_t i = 0; i < SyscallKindCount; ++i)
+            {
+                snapshot.counts[i] = s_syscallCounts[i].load();
+            }
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+            if (getBackend() == net::TransportBackend::Uring)
+            {
+                for (size_t i = 0; i < m_ioThreadPool.getThreadCount(); ++i)
+                {
+                    snapshot.enterCalls += asio::use_service<net::UringService>(m_ioThreadPool.getThreadContext(i)).getStats().enterCalls;
+                }
+            }
+#endif // BYTEBORNE_HAS_IO_URING
+
+            return snapshot;
+        }
+
+    private:
+        static void echo(const net::SessionPtr& session)
+        {
+            net::PacketView packet;
+            while (session->getFrontPacket(packet))
+            {
+                const size_t totalSize = sizeof(net::PacketHeader) + packet.payloadSize;
+                net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+                auto* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+                header->size = static_cast<net::PacketSize>(totalSize);
+                header->id = packet.id;
+                std::memcpy(header + 1, packet.payload, packet.payloadSize);
+
+                chunk->onWritten(totalSize);
+                chunk->close();
+
+                session->send(chunk);
+                session->popFrontPacket();
+            }
+
+            session->receive();
+        }
+
+        void processEvents()
+        {
+            net::ServiceEventPtr serviceEvent;
+            while (m_serviceEventQueue.pop(serviceEvent))
+            {
+                if (serviceEvent->type == net::ServiceEventType::Close)
+                {
+                    m_serviceClosed = true;
+                    continue;
+                }
+
+                if (serviceEvent->type != net::ServiceEventType::Accept)
+                {
+                    continue;
+                }
+
+                const net::SessionPtr& session = static_cast<net::ServiceAcceptEvent*>(serviceEvent.get())->session;
+                m_sessions[session->getSessionId()] = session;
+                session->start();
+                m_startedCount.fetch_add(1);
+            }
+
+            net::SessionEventPtr sessionEvent;
+            while (m_sessionEventQueue.pop(sessionEvent))
+            {
+                auto it = m_sessions.find(sessionEvent->sessionId);
+                if (it == m_sessions.end())
+                {
+                    continue;
+                }
+
+                if (sessionEvent->type == net::SessionEventType::Receive)
+                {
+                    echo(it->second);
+                }
+                else if (sessionEvent->type == net::SessionEventType::Close)
+                {
+                    m_ioThreadPool.releaseSessionContext(asio::query(it->second->getExecutor(), asio::execution::context));
+                    m_sessions.erase(it);
+                }
+            }
+        }
+
+    private:
+        std::atomic<bool> m_running = false;
+        std::atomic<size_t> m_startedCount = 0;
+        bool m_serviceClosed = false;
+        net::IoThreadPool m_ioThreadPool;
+        net::ServiceEventQueue m_serviceEventQueue;
+        net::SessionEventQueue m_sessionEventQueue;
+        net::ServerServicePtr m_service;
+        std::unordered_map<net::SessionId, net::SessionPtr> m_sessions; // 이벤트 스레드에서만 사용
+        std::thread m_eventThread;
+    };
+
+    // 연결마다 패킷 하나를 보내고 응답을 다 받으면 다시 보내는 논블로킹 클라이언트 (epoll 하나로 모든 연결을 돌린다)
+    class PingClient
+    {
+    public:
+        explicit PingClient(const BenchConfig& config)
+            : m_packetSize(sizeof(net::PacketHeader) + config.payloadSize)
+            , m_request(m_packetSize, 0x5A)
+            , m_connections(config.connectionCount)
+        {
+            auto* header = reinterpret_cast<net::PacketHeader*>(m_request.data());
+            header->size = static_cast<net::PacketSize>(m_packetSize);
+            header->id = EchoPacketId;
+        }
+
+        ~PingClient()
+        {
+            for (Connection& connection : m_connections)
+            {
+                if (connection.fd >= 0)
+                {
+                    ::close(connection.fd);
+                }
+            }
+
+            if (m_epollFd >= 0)
+            {
+                ::close(m_epollFd);
+            }
+        }
+
+        // 모든 연결을 블로킹으로 맺은 뒤 논블로킹으로 바꾼다
+        bool connect()
+        {
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(BenchPort);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            m_epollFd = ::epoll_create1(0);
+            for (size_t i = 0; i < m_connections.size(); ++i)
+            {
+                const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+                if ((fd < 0) || (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0))
+                {
+                    spdlog::error("[UringBench] 연결 실패: {} ({})", i, std::strerror(errno));
+                    if (fd >= 0)
+                    {
+                        ::close(fd);
+                    }
+                    return false;
+                }
+
+                const int noDelay = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+                epoll_event event = {};
+                event.events = EPOLLIN;
+                event.data.u64 = i;
+                ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+
+                m_connections[i].fd = fd;
+            }
+
+            return true;
+        }
+
+        // 연결마다 첫 요청을 보낸다 (이후로는 응답을 받을 때마다 다음 요청을 보내므로 연결마다 항상 하나가 진행 중)
+        void start()
+        {
+            for (Connection& connection : m_connections)
+            {
+                sendRequest(connection);
+            }
+        }
+
+        // duration 동안 왕복을 반복하고 완료한 왕복 수 반환
+        uint64_t run(std::chrono::nanoseconds duration)
+        {
+            uint64_t roundTripCount = 0;
+            std::vector<epoll_event> events(1024);
+            std::vector<uint8_t> buffer(64 * 1024);
+
+            const auto deadline = bench::Clock::now() + duration;
+            while (bench::Clock::now() < deadline)
+            {
+                const int eventCount = ::epoll_wait(m_epollFd, events.data(), static_cast<int>(events.size()), 10);
+                for (int i = 0; i < eventCount; ++i)
+                {
+                    Connection& connection = m_connections[events[i].data.u64];
+
+                    const ssize_t bytesRead = ::recv(connection.fd, buffer.data(), buffer.size(), 0);
+                    if (bytesRead <= 0)
+                    {
+                        continue;
+                    }
+
+                    connection.receivedBytes += static_cast<size_t>(bytesRead);
+                    if (connection.receivedBytes >= m_packetSize)
+                    {
+                        connection.receivedBytes -= m_packetSize;
+                        ++roundTripCount;
+                        sendRequest(connection);
+                    }
+                }
+            }
+
+            return roundTripCount;
+        }
+
+    private:
+        struct Connection
+        {
+            int fd = -1;
+            size_t receivedBytes = 0;
+        };
+
+        void sendRequest(Connection& connection)
+        {
+            // 작은 패킷 하나는 빈 소켓 버퍼에 한 번에 들어간다
+            [[maybe_unused]] const ssize_t bytesWritten = ::send(connection.fd, m_request.data(), m_request.size(), MSG_NOSIGNAL);
+        }
+
+    private:
+        const size_t m_packetSize;
+        std::vector<uint8_t> m_request;
+        std::vector<Connection> m_connections;
+        int m_epollFd = -1;
+    };
+
+    void runBackend(net::TransportBackend backend, const BenchConfig& config)
+    {
+        EchoServer server(backend, config.threadCount);
+        const char* backendName = (server.getBackend() == net::TransportBackend::Uring) ? "io_uring" : "socket";
+        server.start();
+
+        {
+            PingClient client(config);
+            if (client.connect())
+            {
+                // 모든 세션이 시작된 뒤, 준비 실행으로 세션의 버퍼와 링을 데운다
+                const auto deadline = bench::Clock::now() + 10s;
+                while ((server.getStartedCount() < config.connectionCount) && (bench::Clock::now() < deadline))
+                {
+                    std::this_thread::sleep_for(1ms);
+                }
+
+                client.start();
+                client.run(500ms);
+
+                const SyscallSnapshot before = server.takeSnapshot();
+                const auto cpuBefore = bench::getProcessCpuTime();
+                const auto startTime = bench::Clock::now();
+
+                const uint64_t roundTripCount = client.run(std::chrono::seconds(config.seconds));
+
+                const double elapsed = std::chrono::duration<double>(bench::Clock::now() - startTime).count();
+                const double cpu = std::chrono::duration<double>(bench::getProcessCpuTime() - cpuBefore).count();
+                const SyscallSnapshot after = server.takeSnapshot();
+
+                // 서버가 주고받은 메시지 = 받은 패킷 + 돌려보낸 패킷
+                const double messageCount = static_cast<double>(std::max<uint64_t>(roundTripCount, 1) * 2);
+                auto perMessage = [&](uint64_t afterCount, uint64_t beforeCount)
+                {
+                    return static_cast<double>(afterCount - beforeCount) / messageCount;
+                };
+
+                spdlog::info("[UringBench] {}: {} connections, {:.0f} round trips/s, {:.1f} us CPU per round trip",
+                    backendName, config.connectionCount, roundTripCount / elapsed, cpu * 1e6 / std::max<uint64_t>(roundTripCount, 1));
+                spdlog::info("[UringBench] {}: {:.3f} server syscalls per message (epoll_wait {:.3f}, receive {:.3f}, send {:.3f}, io_uring_enter {:.3f})",
+                    backendName, perMessage(after.getTotal(), before.getTotal()),
+                    perMessage(after.counts[EpollWait], before.counts[EpollWait]),
+                    perMessage(after.counts[Receive], before.counts[Receive]),
+                    perMessage(after.counts[Send], before.counts[Send]),
+                    perMessage(after.enterCalls, before.enterCalls));
+            }
+        }
+
+        server.stop();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    BenchConfig config;
+    config.connectionCount = std::max<size_t>(bench::getArgument(argc, argv, 1, config.connectionCount), 1);
+    config.seconds = std::max<size_t>(bench::getArgument(argc, argv, 2, config.seconds), 1);
+    config.payloadSize = std::min(bench::getArgument(argc, argv, 3, config.payloadSize), net::ReceiveBuffer::DefaultSize - sizeof(net::PacketHeader));
+    config.threadCount = std::max<size_t>(bench::getArgument(argc, argv, 4, config.threadCount), 1);
+
+    // 클라이언트는 메인 스레드에서 돌리므로 메인 스레드의 호출은 세지 않는다 (IO 스레드와 이벤트 스레드는 이후에 생성)
+    t_excluded = true;
+
+    runBackend(net::TransportBackend::Socket, config);
+
+    if (net::isTransportBackendAvailable(net::TransportBackend::Uring))
+    {
+        runBackend(net::TransportBackend::Uring, config);
+    }
+    else
+    {
+        spdlog::warn("[UringBench] io_uring 백엔드를 사용할 수 없어 socket 백엔드만 측정");
+    }
+
+    core::AppContext::getInstance().cleanup();
+
+    return 0;
+}
+#else
+int main()
+{
+    spdlog::error("[UringBench] Linux에서만 실행할 수 있다");
+    return 0;
+}
+#endif // __linux__
@@ -0,0 +1,60 @@
+﻿#include "TimingWheel.h"
+
+namespace core
+{
+    TimingWheel::TimingWheel(Duration tickInterval, size_t slotCount, TimePoint startTime)
+        : m_tickInterval(tickInterval)
+        , m_slots(slotCount)
+        , m_currentSlotTime(startTime)
+    {
+        assert(Duration::zero() < m_tickInterval);
+        assert(0 < slotCount);
+    }
+
+    void TimingWheel::schedule(Key key, TimePoint expireTime)
+    {
+        // 이미 지난 시간은 현재 슬롯에 넣어 다음 advance()에서 꺼낸다
+        size_t ticks = 0;
+        if (m_currentSlotTime < expireTime)
+        {
+            ticks = static_cast<size_t>((expireTime - m_currentSlotTime) / m_tickInterval);
+        }
+
+        const size_t slotCount = m_slots.size();
+        m_slots[(m_currentSlot + ticks) % slotCount].push_back(Entry{ key, ticks / slotCount });
+        ++m_entryCount;
+    }
+
+    size_t TimingWheel::advance(TimePoint now, std::vector<Key>& expiredKeys)
+    {
+        size_t expiredCount = 0;
+
+        // 구간이 완전히 지나간 슬롯만 처리
+        while (m_currentSlotTime + m_tickInterval <= now)
+        {
+            std::vector<Entry>& slot = m_slots[m_currentSlot];
+
+            size_t keptCount = 0;
+            for (Entry& entry : slot)
+            {
+                if (entry.rounds == 0)
+                {
+                    expiredKeys.push_back(entry.key);
+                    ++expiredCount;
+                    continue;
+                }
+
+                --entry.rounds;
+                slot[keptCount++] = entry;
+            }
+
+            m_entryCount -= slot.size() - keptCount;
+            slot.resize(keptCount);
+
+            m_currentSlot = (m_currentSlot + 1) % m_slots.size();
+            m_currentSlotTime += m_tickInterval;
+        }
+
+        return expiredCount;
+    }
+}
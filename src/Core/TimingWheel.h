@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+namespace core
+{
+    // 만료 시간을 고정 간격의 슬롯에 나눠 담는 해시 타이밍 휠
+    // 등록은 O(1)이고 advance()는 지나간 슬롯만 확인하므로 항목이 많아도 틱마다 드는 비용이 작다
+    // 취소는 지원하지 않으므로 만료된 키가 아직 유효한지는 사용하는 쪽에서 확인한다
+    class TimingWheel
+    {
+    public:
+        using Key = uint64_t;
+        using TimePoint = std::chrono::steady_clock::time_point;
+        using Duration = std::chrono::milliseconds;
+
+    public:
+        // tickInterval: 슬롯 하나가 담당하는 시간 (만료 처리의 정밀도)
+        // slotCount: 슬롯 수 (tickInterval * slotCount보다 먼 만료 시간은 남은 바퀴 수와 함께 저장)
+        TimingWheel(Duration tickInterval, size_t slotCount, TimePoint startTime = std::chrono::steady_clock::now());
+
+        // 만료 시간 등록 (만료 시간보다 일찍 꺼내지는 않으며, 최대 tickInterval만큼 늦을 수 있음)
+        void schedule(Key key, TimePoint expireTime);
+
+        // now까지 지나간 슬롯에서 만료된 키를 expiredKeys 뒤에 추가
+        // 반환값: 추가한 키 개수
+        size_t advance(TimePoint now, std::vector<Key>& expiredKeys);
+
+        size_t size() const { return m_entryCount; }
+        bool isEmpty() const { return m_entryCount == 0; }
+
+    private:
+        struct Entry
+        {
+            Key key;
+            size_t rounds; // 만료되기 전까지 이 슬롯을 더 지나쳐야 하는 횟수
+        };
+
+        Duration m_tickInterval;
+        std::vector<std::vector<Entry>> m_slots;
+        size_t m_currentSlot = 0;
+        TimePoint m_currentSlotTime; // 현재 슬롯이 담당하는 구간의 시작 시간
+        size_t m_entryCount = 0;
+    };
+}
@@ -2,13 +2,36 @@
 #include "Network/Packet.h"
 #include "Protocol/Type.h"
 #include <chrono>
+#include <algorithm>
 
-DummyClient::DummyClient()
+namespace
+{
+    // 서버의 유휴 연결 종료 시간(15초)보다 충분히 짧게 유지
+    constexpr auto HeartbeatInterval = std::chrono::seconds(5);
+
+    constexpr auto ChatInterval = std::chrono::milliseconds(500);
+    constexpr auto TickInterval = std::chrono::milliseconds(50);
+
+    // 이보다 오래 돌아오지 않은 채팅은 서버가 버린 것으로 센다
+    constexpr int64_t ChatLostAfterMs = 10000;
+
+    int64_t NowMs()
+    {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    }
+}
+
+DummyClient::DummyClient(uint32_t floodChatsPerTick, uint32_t floodSessionCount, uint32_t normalSessionCount)
     : m_running(false)
-    , m_messageSerializer(m_sendBufferManager)
+    , m_floodChatsPerTick(floodChatsPerTick)
+    , m_floodSessionCount((0 < floodChatsPerTick) ? floodSessionCount : 0)
 {
     m_clientService = net::ClientService::createInstance(
-        m_ioThreadPool.getContext(), m_serviceEventQueue, net::ResolveTarget{"localhost", "12345"}, 10);
+        m_ioThreadPool.getContext(),
+        m_serviceEventQueue,
+        net::ResolveTarget{"localhost", "12345"},
+        m_floodSessionCount + normalSessionCount);
 
     registerMessageHandlers();
 }
@@ -58,7 +81,6 @@ void DummyClient::join()
 
 void DummyClient::loop()
 {
-    constexpr auto TickInterval = std::chrono::milliseconds(50);
     auto lastTickCountTime = std::chrono::steady_clock::now();
     int32_t tickCount = 0;
 
@@ -79,6 +101,8 @@ void DummyClient::loop()
         if (std::chrono::seconds(1) <= tickCountElapsed)
         {
             spdlog::debug("[DummyClient] 틱 카운트: {}", tickCount);
+            logFloodStats();
+            logChatRoundTrips();
             lastTickCountTime = end;
             tickCount = 0;
         }
@@ -152,38 +176,16 @@ void DummyClient::handleServiceEvent(net::ServiceConnectEvent& event)
 
     auto session = net::Session::createInstance(std::move(event.socket), m_sessionEventQueue);
     m_sessionManager.addSession(session);
-    session->start();
 
-    // 테스트: 주기적으로 C2S_Chat 전송(권위 필드 포함)
-    m_timer.scheduleRepeating(
-        std::chrono::milliseconds(0),
-        std::chrono::milliseconds(500),
-        [this, sessionId = session->getSessionId()]()
-        {
-            if (!m_running.load())
-                return false;
-
-            const uint64_t clientMessageId = m_nextClientMessageId.fetch_add(1);
-            const int64_t clientSentAtMs = [](){
-                using namespace std::chrono; return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
-            }();
-
-            proto::C2S_Chat chat;
-            chat.set_sender_name("더미"); // 서버는 신뢰하지 않음
-            chat.set_content("Hello, Byteborne World!");
-            chat.set_client_message_id(clientMessageId);
-            chat.set_client_sent_at_ms(clientSentAtMs);
-
-            net::SendBufferChunkPtr chunk =  m_messageSerializer.serializeToSendBuffer(chat);
-            if (m_sessionManager.send(sessionId, chunk) == false)
-            {
-                spdlog::warn("[DummyClient] 세션 {} 전송 실패", sessionId);
-                return false;
-            }
+    // 도배 세션 수를 채울 때까지 먼저 연결된 세션이 도배 세션이 된다
+    if (m_floodSessions.size() < m_floodSessionCount)
+    {
+        m_floodSessions.insert(session->getSessionId());
+    }
 
-            return true; // continue scheduling
-        }
-    );
+    session->start();
+    scheduleHeartbeat(session->getSessionId());
+    scheduleChat(session->getSessionId());
 }
 
 void DummyClient::processSessionEvents()
@@ -210,6 +212,8 @@ void DummyClient::processSessionEvents()
 void DummyClient::handleSessionEvent(net::SessionCloseEvent& event)
 {
     m_sessionManager.removeSession(event.sessionId);
+    m_floodSessions.erase(event.sessionId);
+    ++m_disconnectCount;
 }
 
 void DummyClient::handleSessionEvent(net::SessionReceiveEvent& event)
@@ -254,10 +258,167 @@ void DummyClient::registerMessageHandlers()
         {
             handleMessage(sessionId, *std::static_pointer_cast<proto::S2C_Chat>(message));
         });
+
+    m_messageDispatcher.registerHandler(
+        proto::MessageType::S2C_Heartbeat,
+        [this](net::SessionId sessionId, const proto::MessagePtr& message)
+        {
+            handleMessage(sessionId, *std::static_pointer_cast<proto::S2C_Heartbeat>(message));
+        });
+}
+
+void DummyClient::scheduleHeartbeat(net::SessionId sessionId)
+{
+    m_timer.scheduleRepeating(
+        HeartbeatInterval,
+        HeartbeatInterval,
+        [this, sessionId]()
+        {
+            if (!m_running.load())
+                return false;
+
+            proto::C2S_Heartbeat heartbeat;
+            heartbeat.set_client_sent_at_ms(NowMs());
+
+            net::SendBufferChunkPtr chunk = m_messageSerializer.serializeToSendBuffer(heartbeat);
+
+            // 세션이 제거되면 반복 중단
+            return m_sessionManager.send(sessionId, chunk);
+        });
+}
+
+void DummyClient::scheduleChat(net::SessionId sessionId)
+{
+    // 도배 세션은 틱마다 여러 개를, 일반 세션은 주기적으로 하나씩 보낸다
+    const bool flooding = (m_floodSessions.count(sessionId) != 0);
+    const auto interval = flooding ? TickInterval : ChatInterval;
+    const uint32_t chatsPerInterval = flooding ? m_floodChatsPerTick : 1;
+
+    m_timer.scheduleRepeating(
+        std::chrono::milliseconds(0),
+        interval,
+        [this, sessionId, chatsPerInterval]()
+        {
+            if (!m_running.load())
+                return false;
+
+            for (uint32_t i = 0; i < chatsPerInterval; ++i)
+            {
+                if (!sendChat(sessionId))
+                {
+                    spdlog::warn("[DummyClient] 세션 {} 전송 실패", sessionId);
+                    return false;
+                }
+            }
+
+            return true; // continue scheduling
+        });
+}
+
+bool DummyClient::sendChat(net::SessionId sessionId)
+{
+    // 테스트: C2S_Chat 전송(권위 필드 포함)
+    const uint64_t clientMessageId = m_nextClientMessageId.fetch_add(1);
+
+    proto::C2S_Chat chat;
+    chat.set_sender_name("더미"); // 서버는 신뢰하지 않음
+    chat.set_content("Hello, Byteborne World!");
+    chat.set_client_message_id(clientMessageId);
+    chat.set_client_sent_at_ms(NowMs());
+
+    net::SendBufferChunkPtr chunk = m_messageSerializer.serializeToSendBuffer(chat);
+    if (!m_sessionManager.send(sessionId, chunk))
+    {
+        return false;
+    }
+
+    if (m_floodSessions.count(sessionId) == 0)
+    {
+        // 브로드캐스트로 돌아온 자기 채팅의 client_message_id로 왕복 시간을 잰다
+        m_pendingChats.emplace(clientMessageId, PendingChat{ sessionId, chat.client_sent_at_ms() });
+    }
+
+    ++m_sentChatCount;
+    return true;
+}
+
+void DummyClient::logFloodStats()
+{
+    if (m_floodChatsPerTick == 0)
+    {
+        return;
+    }
+
+    // 서버가 버린 채팅은 브로드캐스트되지 않으므로 받은 채팅 수(연결마다 한 번씩 받는다)로 제한을 통과한 양을 확인
+    spdlog::info(
+        "[DummyClient] 도배: 보낸 채팅 {}, 받은 채팅 {}, 연결 종료 {}",
+        m_sentChatCount,
+        m_receivedChatCount,
+        m_disconnectCount);
+
+    m_sentChatCount = 0;
+    m_receivedChatCount = 0;
+    m_disconnectCount = 0;
+}
+
+void DummyClient::logChatRoundTrips()
+{
+    const int64_t now = NowMs();
+    for (auto it = m_pendingChats.begin(); it != m_pendingChats.end();)
+    {
+        if (ChatLostAfterMs <= now - it->second.clientSentAtMs)
+        {
+            ++m_lostChatCount;
+            it = m_pendingChats.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_chatRoundTrips.empty() && (m_lostChatCount == 0))
+    {
+        return;
+    }
+
+    int64_t p50 = 0;
+    int64_t p99 = 0;
+    if (!m_chatRoundTrips.empty())
+    {
+        std::sort(m_chatRoundTrips.begin(), m_chatRoundTrips.end());
+        p50 = m_chatRoundTrips[m_chatRoundTrips.size() / 2];
+        p99 = m_chatRoundTrips[std::min(m_chatRoundTrips.size() - 1, m_chatRoundTrips.size() * 99 / 100)];
+    }
+
+    spdlog::info(
+        "[DummyClient] 일반 세션 채팅 왕복(ms): 샘플 {}, p50 {}, p99 {}, 유실 {}",
+        m_chatRoundTrips.size(),
+        p50,
+        p99,
+        m_lostChatCount);
+
+    m_chatRoundTrips.clear();
+    m_lostChatCount = 0;
 }
 
 void DummyClient::handleMessage(net::SessionId sessionId, const proto::S2C_Chat& message)
 {
+    ++m_receivedChatCount;
+
+    auto pending = m_pendingChats.find(message.client_message_id());
+    if ((pending != m_pendingChats.end()) && (pending->second.sessionId == sessionId))
+    {
+        m_chatRoundTrips.push_back(NowMs() - pending->second.clientSentAtMs);
+        m_pendingChats.erase(pending);
+    }
+
+    if (0 < m_floodChatsPerTick)
+    {
+        // 도배 중에는 채팅마다 로그를 남기지 않고 1초마다 합계만 출력
+        return;
+    }
+
     spdlog::info(
         "[DummyClient] Session {}: S2C_Chat 수신: sender='{}' content='{}' smid={} cmid={} at={}",
         sessionId,
@@ -267,3 +428,11 @@ void DummyClient::handleMessage(net::SessionId sessionId, const proto::S2C_Chat&
         message.client_message_id(),
         message.server_sent_at_ms());
 }
+
+void DummyClient::handleMessage(net::SessionId sessionId, const proto::S2C_Heartbeat& message)
+{
+    spdlog::debug(
+        "[DummyClient] Session {}: S2C_Heartbeat 수신: rtt={}ms",
+        sessionId,
+        NowMs() - message.client_sent_at_ms());
+}
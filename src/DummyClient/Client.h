@@ -2,6 +2,8 @@
 
 #include <thread>
 #include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 #include "Core/Timer.h"
 #include "Network/Session.h"
 #include "Network/Service.h"
@@ -12,7 +14,9 @@
 class DummyClient
 {
 public:
-    DummyClient();
+    // floodChatsPerTick이 0보다 크면 floodSessionCount개 세션이 틱마다 그만큼 채팅을 보내 서버의 수신 속도 제한을 시험한다
+    // 나머지 normalSessionCount개 세션은 평소처럼 채팅하며 도배 중의 채팅 왕복 시간을 잰다
+    explicit DummyClient(uint32_t floodChatsPerTick = 0, uint32_t floodSessionCount = 0, uint32_t normalSessionCount = 10);
 
     void start();
     void stop();
@@ -33,6 +37,12 @@ private:
     void processMessages();
     void registerMessageHandlers();
     void handleMessage(net::SessionId sessionId, const proto::S2C_Chat& message);
+    void handleMessage(net::SessionId sessionId, const proto::S2C_Heartbeat& message);
+    void scheduleHeartbeat(net::SessionId sessionId);
+    void scheduleChat(net::SessionId sessionId);
+    bool sendChat(net::SessionId sessionId);
+    void logFloodStats();
+    void logChatRoundTrips();
 
 private:
     std::atomic<bool> m_running;
@@ -43,11 +53,28 @@ private:
     net::ClientServicePtr m_clientService;
     net::SessionEventQueue m_sessionEventQueue;
     net::SessionManager m_sessionManager;
-    net::SendBufferManager m_sendBufferManager;
     proto::MessageQueue m_messageQueue;
     proto::MessageDispatcher m_messageDispatcher;
     proto::MessageSerializer m_messageSerializer;
 
     // 낙관적 UI 테스트를 위한 더미 client_message_id 카운터
     std::atomic<uint64_t> m_nextClientMessageId{1};
+
+    // 도배 모드 (메인 스레드에서만 사용)
+    uint32_t m_floodChatsPerTick = 0;
+    uint32_t m_floodSessionCount = 0;
+    std::unordered_set<net::SessionId> m_floodSessions;
+    uint64_t m_sentChatCount = 0;
+    uint64_t m_receivedChatCount = 0;
+    uint64_t m_disconnectCount = 0;
+
+    // 일반 세션이 보낸 채팅의 왕복 시간 (메인 스레드에서만 사용)
+    struct PendingChat
+    {
+        net::SessionId sessionId;
+        int64_t clientSentAtMs;
+    };
+    std::unordered_map<uint64_t, PendingChat> m_pendingChats; // client_message_id -> 보낸 세션과 시각
+    std::vector<int64_t> m_chatRoundTrips;
+    uint64_t m_lostChatCount = 0;
 };
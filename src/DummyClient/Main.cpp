@@ -1,12 +1,19 @@
 ﻿#include "Core/Context.h"
 #include "Client.h"
 
-int main()
+// 사용법: DummyClient [도배 세션이 틱마다 보낼 채팅 수] [도배 세션 수] [일반 세션 수]
+// 채팅 수가 0이면 모든 세션이 500ms마다 하나씩 보낸다 (도배 세션 수를 생략하면 10개 세션이 모두 도배)
+int main(int argc, char* argv[])
 {
     core::AppContext::getInstance().initialize();
 
+    const uint32_t floodChatsPerTick = (1 < argc) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 0;
+    const uint32_t floodSessionCount = (2 < argc) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 10;
+    const uint32_t normalSessionCount = (3 < argc) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10))
+                                                   : ((0 < floodChatsPerTick) ? 0 : 10);
+
     {
-        DummyClient client;
+        DummyClient client(floodChatsPerTick, floodSessionCount, normalSessionCount);
         client.start();
 
 #ifdef _DEBUG
@@ -6,11 +6,16 @@
 #include <windows.h>
 #endif
 
+namespace
+{
+    // 서버의 유휴 연결 종료 시간(15초)보다 충분히 짧게 유지
+    constexpr auto HeartbeatInterval = std::chrono::seconds(5);
+}
+
 GameClient::GameClient()
     : m_running(false)
     , m_shape(50.f)
     , m_clearColor(sf::Color::Black)
-    , m_messageSerializer(m_sendBufferManager)
 {    
     // 매니저들 초기화
     m_fontManager = std::make_unique<FontManager>();
@@ -420,6 +425,7 @@ void GameClient::handleServiceEvent(net::ServiceConnectEvent& event)
     
     m_serverSessionId = session->getSessionId();
     m_connected.store(true);
+    scheduleHeartbeat(m_serverSessionId);
     
     spdlog::info("[GameClient] 서버에 연결되었습니다. Session ID: {}", m_serverSessionId);
     
@@ -516,6 +522,46 @@ void GameClient::registerMessageHandlers()
         {
             handleMessage(sessionId, *std::static_pointer_cast<proto::S2C_Chat>(message));
         });
+
+    m_messageDispatcher.registerHandler(
+        proto::MessageType::S2C_Heartbeat,
+        [this](net::SessionId sessionId, const proto::MessagePtr& message)
+        {
+            handleMessage(sessionId, *std::static_pointer_cast<proto::S2C_Heartbeat>(message));
+        });
+}
+
+void GameClient::scheduleHeartbeat(net::SessionId sessionId)
+{
+    m_timer.scheduleRepeating(
+        HeartbeatInterval,
+        HeartbeatInterval,
+        [this, sessionId]()
+        {
+            if (!m_running.load())
+                return false;
+
+            const int64_t clientSentAtMs = [](){
+                using namespace std::chrono; return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+            }();
+
+            proto::C2S_Heartbeat heartbeat;
+            heartbeat.set_client_sent_at_ms(clientSentAtMs);
+
+            net::SendBufferChunkPtr chunk = m_messageSerializer.serializeToSendBuffer(heartbeat);
+
+            // 연결이 끊겨 세션이 제거되면 반복 중단
+            return m_sessionManager.send(sessionId, chunk);
+        });
+}
+
+void GameClient::handleMessage(net::SessionId sessionId, const proto::S2C_Heartbeat& message)
+{
+    const int64_t nowMs = [](){
+        using namespace std::chrono; return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    }();
+
+    spdlog::debug("[GameClient] Session {}: S2C_Heartbeat 수신: rtt={}ms", sessionId, nowMs - message.client_sent_at_ms());
 }
 
 void GameClient::handleMessage(net::SessionId sessionId, const proto::S2C_Chat& message)
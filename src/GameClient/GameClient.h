@@ -77,6 +77,8 @@ private:
     void processMessages();
     void registerMessageHandlers();
     void handleMessage(net::SessionId sessionId, const proto::S2C_Chat& message);
+    void handleMessage(net::SessionId sessionId, const proto::S2C_Heartbeat& message);
+    void scheduleHeartbeat(net::SessionId sessionId);
 
 private:
     // 실행 상태
@@ -101,7 +103,6 @@ private:
     net::ClientServicePtr m_clientService;
     net::SessionEventQueue m_sessionEventQueue;
     net::SessionManager m_sessionManager;
-    net::SendBufferManager m_sendBufferManager;
     proto::MessageQueue m_messageQueue;
     proto::MessageDispatcher m_messageDispatcher;
     proto::MessageSerializer m_messageSerializer;
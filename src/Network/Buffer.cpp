@@ -46,16 +46,16 @@ namespace net
         }
     }
 
-    SendBufferChunk::SendBufferChunk(const SendBufferPtr& owner, uint8_t* chunk, size_t openSize)
+    SendBufferChunk::SendBufferChunk(const SendBuffer& owner, uint8_t* chunk, size_t openSize)
         : m_owner(owner)
         , m_chunk(chunk)
         , m_openSize(openSize)
     {
-        assert(m_owner->isClosed() == false);
-        assert(m_openSize <= m_owner->getFreeSize());
+        assert(m_owner.isClosed() == false);
+        assert(m_openSize <= m_owner.getFreeSize());
     }
 
-    SendBufferChunkPtr SendBufferChunk::create(const SendBufferPtr& owner, uint8_t* chunk, size_t openSize)
+    SendBufferChunkPtr SendBufferChunk::create(const SendBuffer& owner, uint8_t* chunk, size_t openSize)
     {
         return std::make_shared<SendBufferChunk>(owner, chunk, openSize);
     }
@@ -74,20 +74,60 @@ namespace net
         m_closed = true;
 
         // SendBuffer 쓰기 종료 처리
-        m_owner->close(m_writeOffset);
+        m_owner.close(m_writeOffset);
     }
 
-    SendBuffer::SendBuffer(size_t size)
+    SendBuffer::SendBuffer(SendBufferBlock* block)
+        : m_block(block)
     {
-        m_buffer.resize(size);
+        m_block->refCount.fetch_add(1, std::memory_order_relaxed);
     }
 
-    SendBuffer::~SendBuffer()
-    {}
+    SendBuffer::SendBuffer(const SendBuffer& other)
+        : m_block(other.m_block)
+    {
+        if (m_block)
+        {
+            m_block->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SendBuffer& SendBuffer::operator=(const SendBuffer& other)
+    {
+        SendBuffer copy(other);
+        std::swap(m_block, copy.m_block);
+        return *this;
+    }
 
-    SendBufferPtr SendBuffer::create(size_t size)
+    SendBuffer& SendBuffer::operator=(SendBuffer&& other) noexcept
     {
-        return std::make_shared<SendBuffer>(size);
+        if (this != &other)
+        {
+            reset();
+            m_block = std::exchange(other.m_block, nullptr);
+        }
+        return *this;
+    }
+
+    SendBuffer SendBuffer::create(size_t size)
+    {
+        // 재사용한 블록에는 이전 버퍼의 상태가 남아 있으므로 초기화
+        SendBufferBlock* block = SendBufferPool::getLocal().acquire(size);
+        assert(block->refCount.load(std::memory_order_relaxed) == 0);
+        block->chunkOffset = 0;
+        block->chunkOpen = false;
+
+        return SendBuffer(block);
+    }
+
+    void SendBuffer::reset()
+    {
+        if (m_block && (m_block->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1))
+        {
+            // 마지막 청크가 해제된 스레드와 관계없이 블록을 소유 풀로 반환
+            SendBufferPool::release(m_block);
+        }
+        m_block = nullptr;
     }
 
     SendBufferChunkPtr SendBuffer::open(size_t size)
@@ -95,8 +135,8 @@ namespace net
         assert(isClosed());
         assert(size <= getFreeSize());
 
-        m_closed = false;
-        auto chunk = SendBufferChunk::create(shared_from_this(), getChunkPtr(), size);
+        m_block->chunkOpen = true;
+        auto chunk = SendBufferChunk::create(*this, getChunkPtr(), size);
 
         return chunk;
     }
@@ -106,26 +146,247 @@ namespace net
         assert(isClosed() == false);
         assert(bytesWritten <= getFreeSize());
 
-        m_chunkOffset += bytesWritten;
-        m_closed = true;
+        m_block->chunkOffset += bytesWritten;
+        m_block->chunkOpen = false;
+
+        SendBufferPool::getLocal().onCommitted(bytesWritten);
+    }
+
+    // 스레드가 종료돼도 다른 스레드에서 블록이 반환될 수 있으므로 풀은 해제하지 않고 재사용한다
+    class SendBufferPoolRegistry
+    {
+    public:
+        static SendBufferPoolRegistry& getInstance()
+        {
+            // 스레드 로컬 객체보다 늦게 소멸하도록 의도적으로 해제하지 않음
+            static SendBufferPoolRegistry* s_instance = new SendBufferPoolRegistry();
+            return *s_instance;
+        }
+
+        SendBufferPool* adopt()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_idlePools.empty())
+            {
+                SendBufferPool* pool = m_idlePools.back();
+                m_idlePools.pop_back();
+                return pool;
+            }
+
+            SendBufferPool* pool = new SendBufferPool();
+            m_pools.push_back(pool);
+            return pool;
+        }
+
+        void abandon(SendBufferPool* pool)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_idlePools.push_back(pool);
+        }
+
+        template<typename TFunc>
+        void forEach(TFunc&& func)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (SendBufferPool* pool : m_pools)
+            {
+                func(*pool);
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::vector<SendBufferPool*> m_pools;
+        std::vector<SendBufferPool*> m_idlePools;
+    };
+
+    namespace
+    {
+        thread_local SendBufferPool* t_localPool = nullptr;
+
+        // 스레드 종료 시 풀을 레지스트리에 돌려준다
+        struct LocalPoolHolder
+        {
+            ~LocalPoolHolder()
+            {
+                if (t_localPool)
+                {
+                    SendBufferPoolRegistry::getInstance().abandon(t_localPool);
+                    t_localPool = nullptr;
+                }
+            }
+        };
+
+        thread_local LocalPoolHolder t_localPoolHolder;
     }
 
-    SendBufferManager::SendBufferManager()
+    SendBufferPool& SendBufferPool::getLocal()
     {
-        m_currentBuffer = SendBuffer::create();
+        if (t_localPool == nullptr)
+        {
+            // 스레드 종료 시 holder 소멸자가 호출되도록 odr-use
+            (void)&t_localPoolHolder;
+            t_localPool = SendBufferPoolRegistry::getInstance().adopt();
+        }
+
+        return *t_localPool;
     }
 
-    SendBufferChunkPtr SendBufferManager::open(size_t size)
+    SendBufferBlock* SendBufferPool::acquire(size_t size)
     {
-        assert(m_currentBuffer);
-        assert(m_currentBuffer->isClosed());
+        const size_t sizeClass = findSizeClass(size);
+        if (sizeClass == SizeClassCount)
+        {
+            // 가장 큰 등급보다 큰 요청은 풀을 거치지 않고 정확한 크기로 할당
+            addLocal(m_allocatedBlocks, 1);
+            return allocateBlock(this, sizeClass, size);
+        }
 
-        if (m_currentBuffer->getFreeSize() < size)
+        if (m_freeLists[sizeClass] == nullptr)
         {
-            // 현재 버퍼에 충분한 공간이 없으면 새 버퍼로 교체
-            m_currentBuffer = SendBuffer::create();
+            drainRemote();
         }
 
-        return m_currentBuffer->open(size);
+        SendBufferBlock* block = m_freeLists[sizeClass];
+        if (block == nullptr)
+        {
+            addLocal(m_allocatedBlocks, 1);
+            return allocateBlock(this, sizeClass, SizeClasses[sizeClass]);
+        }
+
+        m_freeLists[sizeClass] = block->next;
+        --m_freeCounts[sizeClass];
+        block->next = nullptr;
+        addLocal(m_reusedBlocks, 1);
+
+        return block;
+    }
+
+    void SendBufferPool::release(SendBufferBlock* block)
+    {
+        assert(block);
+        assert(block->owner);
+
+        if (block->sizeClass == SizeClassCount)
+        {
+            block->owner->m_freedBlocks.fetch_add(1, std::memory_order_relaxed);
+            freeBlock(block);
+        }
+        else if (block->owner == t_localPool)
+        {
+            block->owner->pushLocal(block);
+        }
+        else
+        {
+            block->owner->pushRemote(block);
+        }
+    }
+
+    SendBufferPoolStats SendBufferPool::getStats()
+    {
+        SendBufferPoolStats stats;
+        SendBufferPoolRegistry::getInstance().forEach(
+            [&stats](const SendBufferPool& pool)
+            {
+                stats.allocatedBlocks += pool.m_allocatedBlocks.load(std::memory_order_relaxed);
+                stats.freedBlocks += pool.m_freedBlocks.load(std::memory_order_relaxed);
+                stats.reusedBlocks += pool.m_reusedBlocks.load(std::memory_order_relaxed);
+                stats.remoteReturns += pool.m_remoteReturns.load(std::memory_order_relaxed);
+                stats.committedBytes += pool.m_committedBytes.load(std::memory_order_relaxed);
+            });
+
+        return stats;
+    }
+
+    size_t SendBufferPool::findSizeClass(size_t size)
+    {
+        for (size_t i = 0; i < SizeClassCount; ++i)
+        {
+            if (size <= SizeClasses[i])
+            {
+                return i;
+            }
+        }
+
+        return SizeClassCount;
+    }
+
+    SendBufferBlock* SendBufferPool::allocateBlock(SendBufferPool* owner, size_t sizeClass, size_t capacity)
+    {
+        // 데이터 영역은 0으로 초기화하지 않는다
+        void* memory = ::operator new(sizeof(SendBufferBlock) + capacity);
+
+        SendBufferBlock* block = new (memory) SendBufferBlock();
+        block->owner = owner;
+        block->capacity = capacity;
+        block->sizeClass = sizeClass;
+
+        return block;
+    }
+
+    void SendBufferPool::freeBlock(SendBufferBlock* block)
+    {
+        block->~SendBufferBlock();
+        ::operator delete(block);
+    }
+
+    void SendBufferPool::pushLocal(SendBufferBlock* block)
+    {
+        const size_t sizeClass = block->sizeClass;
+        if (MaxCachedBlocks[sizeClass] <= m_freeCounts[sizeClass])
+        {
+            // 캐시 한도를 넘는 블록은 시스템에 반환
+            m_freedBlocks.fetch_add(1, std::memory_order_relaxed);
+            freeBlock(block);
+            return;
+        }
+
+        block->next = m_freeLists[sizeClass];
+        m_freeLists[sizeClass] = block;
+        ++m_freeCounts[sizeClass];
+    }
+
+    void SendBufferPool::pushRemote(SendBufferBlock* block)
+    {
+        m_remoteReturns.fetch_add(1, std::memory_order_relaxed);
+
+        // 소유 스레드가 drainRemote에서 리스트 전체를 한 번에 가져가므로 push만 lock-free로 수행
+        SendBufferBlock* head = m_remoteFreeList.load(std::memory_order_relaxed);
+        do
+        {
+            block->next = head;
+        }
+        while (!m_remoteFreeList.compare_exchange_weak(
+            head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void SendBufferPool::drainRemote()
+    {
+        SendBufferBlock* block = m_remoteFreeList.exchange(nullptr, std::memory_order_acquire);
+        while (block)
+        {
+            SendBufferBlock* next = block->next;
+            pushLocal(block);
+            block = next;
+        }
+    }
+
+    SendBufferManager& SendBufferManager::getLocal()
+    {
+        thread_local SendBufferManager t_instance;
+        return t_instance;
+    }
+
+    SendBufferChunkPtr SendBufferManager::open(size_t size)
+    {
+        if (!m_currentBuffer || (m_currentBuffer.getFreeSize() < size))
+        {
+            // 현재 버퍼에 충분한 공간이 없으면 크기에 맞는 등급의 새 버퍼로 교체
+            m_currentBuffer = SendBuffer::create(std::max(size, SendBuffer::DefaultSize));
+        }
+
+        assert(m_currentBuffer.isClosed());
+
+        return m_currentBuffer.open(size);
     }
 }
@@ -3,6 +3,7 @@
 #include <vector>
 #include <stack>
 #include <mutex>
+#include <utility>
 
 namespace net
 {
@@ -26,6 +27,9 @@ namespace net
         size_t getUnwrittenSize() const { return m_buffer.size() - m_writeOffset; }
         size_t getUnreadSize() const { return m_writeOffset - m_readOffset; }
 
+        // 한 번의 읽기 요청에 사용할 수 있는 크기 (onWritten의 최대 크기 제한)
+        size_t getReadRequestSize() const { return std::min(getUnwrittenSize(), m_size); }
+
     private:
         void resetOffsets();
 
@@ -38,16 +42,132 @@ namespace net
     
     class SendBufferChunk;
     class SendBuffer;
+    class SendBufferPool;
 
     using SendBufferChunkPtr = std::shared_ptr<SendBufferChunk>;
-    using SendBufferPtr = std::shared_ptr<SendBuffer>;
+
+    // 풀에서 재사용되는 송신 버퍼 메모리 블록 (헤더 바로 뒤에 데이터 영역이 이어진다)
+    struct SendBufferBlock
+    {
+        SendBufferPool* owner = nullptr;    // 블록을 할당한 풀
+        SendBufferBlock* next = nullptr;    // 프리 리스트 링크
+        size_t capacity = 0;
+        size_t sizeClass = 0;               // SizeClassCount이면 풀에 보관하지 않는 초대형 블록
+
+        // SendBuffer로 쓸 때의 상태 (버퍼마다 제어 객체를 따로 할당하지 않도록 블록 헤더에 둔다)
+        std::atomic<uint32_t> refCount = 0; // 블록을 가리키는 SendBuffer 핸들 수
+        size_t chunkOffset = 0;
+        bool chunkOpen = false;
+
+        uint8_t* getData() { return reinterpret_cast<uint8_t*>(this + 1); }
+    };
+
+    struct SendBufferPoolStats
+    {
+        uint64_t allocatedBlocks = 0;   // 시스템 할당 횟수
+        uint64_t freedBlocks = 0;       // 시스템 해제 횟수
+        uint64_t reusedBlocks = 0;      // 프리 리스트 재사용 횟수
+        uint64_t remoteReturns = 0;     // 다른 스레드에서 반환된 블록 수
+        uint64_t committedBytes = 0;    // 송신 버퍼에 기록된 바이트 수
+    };
+
+    // 크기 등급별 SendBufferBlock 풀
+    // 스레드마다 하나의 풀을 사용하며, 다른 스레드에서 해제된 블록은 소유 풀의 반환 리스트로 돌아간다
+    class SendBufferPool
+    {
+    public:
+        static constexpr size_t SizeClassCount = 3;
+        static constexpr size_t SizeClasses[SizeClassCount] = { 4096, 16384, 65536 };
+        static constexpr size_t MaxCachedBlocks[SizeClassCount] = { 256, 32, 8 };
+
+    public:
+        SendBufferPool(const SendBufferPool&) = delete;
+        SendBufferPool& operator=(const SendBufferPool&) = delete;
+
+        // 호출한 스레드의 풀 반환
+        static SendBufferPool& getLocal();
+
+        // size 이상의 용량을 가진 블록 할당
+        SendBufferBlock* acquire(size_t size);
+
+        // 블록을 소유 풀에 반환 (어느 스레드에서든 호출 가능)
+        static void release(SendBufferBlock* block);
+
+        void onCommitted(size_t bytesWritten) { addLocal(m_committedBytes, bytesWritten); }
+
+        // 모든 풀의 통계 합산
+        static SendBufferPoolStats getStats();
+
+    private:
+        friend class SendBufferPoolRegistry;
+
+        SendBufferPool() = default;
+
+        static size_t findSizeClass(size_t size);
+        static SendBufferBlock* allocateBlock(SendBufferPool* owner, size_t sizeClass, size_t capacity);
+        static void freeBlock(SendBufferBlock* block);
+
+        void pushLocal(SendBufferBlock* block);
+        void pushRemote(SendBufferBlock* block);
+        void drainRemote();
+
+        // 소유 스레드만 기록하는 카운터이므로 원자적 증가 연산 없이 갱신
+        static void addLocal(std::atomic<uint64_t>& counter, uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    private:
+        SendBufferBlock* m_freeLists[SizeClassCount] = {};
+        size_t m_freeCounts[SizeClassCount] = {};
+        std::atomic<SendBufferBlock*> m_remoteFreeList = nullptr;
+
+        std::atomic<uint64_t> m_allocatedBlocks = 0;
+        std::atomic<uint64_t> m_freedBlocks = 0;
+        std::atomic<uint64_t> m_reusedBlocks = 0;
+        std::atomic<uint64_t> m_remoteReturns = 0;
+        std::atomic<uint64_t> m_committedBytes = 0;
+    };
+
+    // 블록 헤더의 참조 카운트를 공유하는 송신 버퍼 핸들 (복사하면 같은 블록을 가리키고, 마지막 핸들이 블록을 풀로 반환)
+    class SendBuffer
+    {
+    public:
+        static constexpr size_t DefaultSize = 4096;
+
+        SendBuffer() = default;
+        ~SendBuffer() { reset(); }
+        static SendBuffer create(size_t size = DefaultSize);
+
+        SendBuffer(const SendBuffer& other);
+        SendBuffer(SendBuffer&& other) noexcept : m_block(std::exchange(other.m_block, nullptr)) {}
+        SendBuffer& operator=(const SendBuffer& other);
+        SendBuffer& operator=(SendBuffer&& other) noexcept;
+
+        explicit operator bool() const { return m_block != nullptr; }
+
+        SendBufferChunkPtr open(size_t size);
+        void close(size_t bytesWritten);
+
+        bool isClosed() const { return !m_block->chunkOpen; }
+        size_t getCapacity() const { return m_block->capacity; }
+        size_t getFreeSize() const { return m_block->capacity - m_block->chunkOffset; }
+        uint8_t* getChunkPtr() { return m_block->getData() + m_block->chunkOffset; }
+
+    private:
+        explicit SendBuffer(SendBufferBlock* block);
+        void reset();
+
+    private:
+        SendBufferBlock* m_block = nullptr;
+    };
 
     class SendBufferChunk
         : public std::enable_shared_from_this<SendBufferChunk>
     {
     public:
-        SendBufferChunk(const SendBufferPtr& owner, uint8_t* chunk, size_t openSize);
-        static SendBufferChunkPtr create(const SendBufferPtr& owner, uint8_t* chunk, size_t openSize);
+        SendBufferChunk(const SendBuffer& owner, uint8_t* chunk, size_t openSize);
+        static SendBufferChunkPtr create(const SendBuffer& owner, uint8_t* chunk, size_t openSize);
 
         void onWritten(size_t bytesWritten);
         void close();
@@ -60,45 +180,38 @@ namespace net
         size_t getUnwrittenSize() const { return m_openSize - m_writeOffset; }
         bool isClosed() const { return m_closed; }
 
+        // 송신 큐가 밀린 세션에서의 처리 힌트 (세션에 넘기기 전에 설정)
+        void setDroppable(bool droppable) { m_droppable = droppable; }
+        void setCoalesceKey(uint64_t coalesceKey) { m_coalesceKey = coalesceKey; }
+        bool isDroppable() const { return m_droppable; }
+        uint64_t getCoalesceKey() const { return m_coalesceKey; } // 0이면 병합하지 않음
+
     private:
-        SendBufferPtr m_owner;
+        SendBuffer m_owner;
         uint8_t* m_chunk = nullptr;
         size_t m_openSize = 0;
         size_t m_writeOffset = 0;
         bool m_closed = false;
+        bool m_droppable = false;
+        uint64_t m_coalesceKey = 0;
     };
 
-    class SendBuffer
-        : public std::enable_shared_from_this<SendBuffer>
+    // 스레드마다 하나씩 존재하는 송신 버퍼 관리자
+    // 호출한 스레드의 풀에서만 블록을 할당하므로 동기화 없이 여러 스레드에서 동시에 직렬화할 수 있다
+    class SendBufferManager
     {
     public:
-        static constexpr size_t DefaultSize = 4096;
+        static SendBufferManager& getLocal();
 
-        SendBuffer(size_t size = DefaultSize);
-        ~SendBuffer();
-        static SendBufferPtr create(size_t size = DefaultSize);
+        SendBufferManager(const SendBufferManager&) = delete;
+        SendBufferManager& operator=(const SendBufferManager&) = delete;
 
         SendBufferChunkPtr open(size_t size);
-        void close(size_t bytesWritten);
-
-        bool isClosed() const { return m_closed; }
-        size_t getFreeSize() const { return m_buffer.size() - m_chunkOffset; }
-        uint8_t* getChunkPtr() { return m_buffer.data() + m_chunkOffset; }
 
     private:
-        std::vector<uint8_t> m_buffer;
-        size_t m_chunkOffset = 0;
-        bool m_closed = true;
-    };
-
-    class SendBufferManager
-    {
-    public:
-        SendBufferManager();
-
-        SendBufferChunkPtr open(size_t size);
+        SendBufferManager() = default;
 
     private:
-        SendBufferPtr m_currentBuffer;
+        SendBuffer m_currentBuffer;
     };
 }
@@ -0,0 +1,100 @@
+﻿#include "Compression.h"
+#include <algorithm>
+#include <limits>
+#include <lz4.h>
+#include <zstd.h>
+
+namespace net
+{
+    namespace
+    {
+        // 브로드캐스트 청크마다 한 번 압축하므로 압축률보다 속도를 우선
+        constexpr int ZstdCompressionLevel = 1;
+
+        struct ZstdContexts
+        {
+            ZSTD_CCtx* compressContext = ZSTD_createCCtx();
+            ZSTD_DCtx* decompressContext = ZSTD_createDCtx();
+
+            ~ZstdContexts()
+            {
+                ZSTD_freeCCtx(compressContext);
+                ZSTD_freeDCtx(decompressContext);
+            }
+        };
+
+        ZstdContexts& getLocalZstdContexts()
+        {
+            thread_local ZstdContexts t_contexts;
+            return t_contexts;
+        }
+    }
+
+    size_t PacketCompressor::getCompressBound(CompressionCodec codec, size_t srcSize)
+    {
+        switch (codec)
+        {
+        case CompressionCodec::Lz4:
+            return static_cast<size_t>(LZ4_compressBound(static_cast<int>(srcSize)));
+        case CompressionCodec::Zstd:
+            return ZSTD_compressBound(srcSize);
+        default:
+            assert(false);
+            return 0;
+        }
+    }
+
+    size_t PacketCompressor::compress(CompressionCodec codec, const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+    {
+        switch (codec)
+        {
+        case CompressionCodec::Lz4:
+        {
+            const int compressedSize = LZ4_compress_default(
+                reinterpret_cast<const char*>(src),
+                reinterpret_cast<char*>(dst),
+                static_cast<int>(srcSize),
+                static_cast<int>(std::min<size_t>(dstCapacity, std::numeric_limits<int>::max())));
+
+            return (0 < compressedSize) ? static_cast<size_t>(compressedSize) : 0;
+        }
+        case CompressionCodec::Zstd:
+        {
+            const size_t compressedSize = ZSTD_compressCCtx(
+                getLocalZstdContexts().compressContext, dst, dstCapacity, src, srcSize, ZstdCompressionLevel);
+
+            return ZSTD_isError(compressedSize) ? 0 : compressedSize;
+        }
+        default:
+            assert(false);
+            return 0;
+        }
+    }
+
+    bool PacketCompressor::decompress(CompressionCodec codec, const uint8_t* src, size_t srcSize, uint8_t* dst, size_t originalSize)
+    {
+        switch (codec)
+        {
+        case CompressionCodec::Lz4:
+        {
+            const int decompressedSize = LZ4_decompress_safe(
+                reinterpret_cast<const char*>(src),
+                reinterpret_cast<char*>(dst),
+                static_cast<int>(srcSize),
+                static_cast<int>(originalSize));
+
+            return (0 <= decompressedSize) && (static_cast<size_t>(decompressedSize) == originalSize);
+        }
+        case CompressionCodec::Zstd:
+        {
+            const size_t decompressedSize = ZSTD_decompressDCtx(
+                getLocalZstdContexts().decompressContext, dst, originalSize, src, srcSize);
+
+            return !ZSTD_isError(decompressedSize) && (decompressedSize == originalSize);
+        }
+        default:
+            // 알 수 없는 코덱은 잘못된 패킷으로 처리
+            return false;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Packet.h"
+
+namespace net
+{
+    // 패킷 페이로드 압축 코덱 (LZ4: 빠른 속도, zstd: 높은 압축률)
+    // 호출한 스레드의 압축 컨텍스트를 재사용하므로 어느 스레드에서든 잠금 없이 사용할 수 있다
+    class PacketCompressor
+    {
+    public:
+        // srcSize 바이트를 압축할 때 필요한 최대 출력 크기
+        static size_t getCompressBound(CompressionCodec codec, size_t srcSize);
+
+        // 반환값: 압축된 크기 (실패하면 0)
+        static size_t compress(CompressionCodec codec, const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+        // 정확히 originalSize 바이트로 풀렸을 때만 성공
+        static bool decompress(CompressionCodec codec, const uint8_t* src, size_t srcSize, uint8_t* dst, size_t originalSize);
+    };
+}
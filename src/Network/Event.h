@@ -70,20 +70,20 @@ namespace net
     struct ServiceAcceptEvent
         : public ServiceEvent
     {
-        asio::ip::tcp::socket socket;
+        SessionPtr session; // 수락한 IO 스레드에서 생성된 세션 (시작 전)
 
-        ServiceAcceptEvent(asio::ip::tcp::socket&& socket)
+        ServiceAcceptEvent(const SessionPtr& session)
             : ServiceEvent(ServiceEventType::Accept)
-            , socket(std::move(socket))
+            , session(session)
         {}
     };
 
     struct ServiceConnectEvent
         : public ServiceEvent
     {
-        asio::ip::tcp::socket socket;
+        asio::generic::stream_protocol::socket socket;
 
-        ServiceConnectEvent(asio::ip::tcp::socket&& socket)
+        ServiceConnectEvent(asio::generic::stream_protocol::socket&& socket)
             : ServiceEvent(ServiceEventType::Connect)
             , socket(std::move(socket))
         {}
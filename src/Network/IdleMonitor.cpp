@@ -0,0 +1,85 @@
+﻿#include "IdleMonitor.h"
+#include <algorithm>
+
+namespace net
+{
+    IdleSessionMonitor::IdleSessionMonitor(
+        SessionManager& sessionManager,
+        std::chrono::milliseconds idleTimeout,
+        size_t reapBatchSize)
+        : m_sessionManager(sessionManager)
+        , m_idleTimeout(idleTimeout)
+        , m_reapBatchSize(reapBatchSize)
+        , m_wheel(std::max(idleTimeout / TicksPerTimeout, std::chrono::milliseconds(1)), SlotCount)
+    {
+        assert(std::chrono::milliseconds::zero() < m_idleTimeout);
+        assert(0 < m_reapBatchSize);
+    }
+
+    void IdleSessionMonitor::addSession(const SessionPtr& session)
+    {
+        m_wheel.schedule(
+            static_cast<core::TimingWheel::Key>(session->getSessionId()),
+            session->getLastReceiveTime() + m_idleTimeout);
+    }
+
+    size_t IdleSessionMonitor::update(TimePoint now)
+    {
+        m_expiredKeys.clear();
+        m_wheel.advance(now, m_expiredKeys);
+
+        for (core::TimingWheel::Key key : m_expiredKeys)
+        {
+            const SessionId sessionId = static_cast<SessionId>(key);
+
+            SessionPtr session = m_sessionManager.findSession(sessionId);
+            if (!session || !session->isRunning())
+            {
+                // 이미 종료된 세션은 감시 대상에서 제외
+                continue;
+            }
+
+            const TimePoint expireTime = session->getLastReceiveTime() + m_idleTimeout;
+            if (now < expireTime)
+            {
+                // 등록 이후 수신이 있었으면 마지막 수신 시간 기준으로 다시 등록
+                m_wheel.schedule(key, expireTime);
+                continue;
+            }
+
+            m_reapQueue.push_back(sessionId);
+        }
+
+        // 한꺼번에 많은 세션이 만료돼도 틱이 길어지지 않도록 배치 크기만큼만 종료
+        size_t reapedCount = 0;
+        while (!m_reapQueue.empty() && (reapedCount < m_reapBatchSize))
+        {
+            SessionPtr session = m_sessionManager.findSession(m_reapQueue.front());
+            m_reapQueue.pop_front();
+
+            if (!session || !session->isRunning())
+            {
+                continue;
+            }
+
+            const TimePoint expireTime = session->getLastReceiveTime() + m_idleTimeout;
+            if (now < expireTime)
+            {
+                // 대기하는 동안 수신이 있었으면 종료하지 않고 다시 감시
+                m_wheel.schedule(static_cast<core::TimingWheel::Key>(session->getSessionId()), expireTime);
+                continue;
+            }
+
+            session->stop();
+            ++reapedCount;
+        }
+
+        if (0 < reapedCount)
+        {
+            m_reapedCount += reapedCount;
+            spdlog::info("[IdleSessionMonitor] 유휴 세션 {}개 종료 (대기 {}개)", reapedCount, m_reapQueue.size());
+        }
+
+        return reapedCount;
+    }
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include <chrono>
+#include <deque>
+#include <vector>
+#include "Core/TimingWheel.h"
+#include "Session.h"
+
+namespace net
+{
+    // 일정 시간 동안 아무것도 수신하지 못한 세션을 찾아 묶어서 종료
+    // 세션마다 타이머를 두지 않고 하나의 타이밍 휠에 마지막 수신 시간 기준 만료 시간만 등록한다
+    // 수신할 때마다 휠을 갱신하지 않고, 만료 슬롯에 도달했을 때 마지막 수신 시간을 확인해 다시 등록한다
+    // 메인 스레드에서만 사용
+    class IdleSessionMonitor
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        // 한 번의 update()에서 종료하는 최대 세션 수 (나머지는 다음 update()로 미룸)
+        static constexpr size_t DefaultReapBatchSize = 1024;
+
+        // 휠 한 칸의 크기 = idleTimeout / TicksPerTimeout (최대 그만큼 늦게 종료)
+        static constexpr int64_t TicksPerTimeout = 8;
+        static constexpr size_t SlotCount = static_cast<size_t>(TicksPerTimeout * 2);
+
+    public:
+        IdleSessionMonitor(
+            SessionManager& sessionManager,
+            std::chrono::milliseconds idleTimeout,
+            size_t reapBatchSize = DefaultReapBatchSize);
+
+        // 세션 감시 시작 (세션이 제거되면 다음 만료 확인 때 자동으로 빠진다)
+        void addSession(const SessionPtr& session);
+
+        // 만료 시간이 지난 세션을 확인하고 유휴 세션을 최대 reapBatchSize개까지 종료
+        // 게임 루프에서 매 틱마다 호출해야 함
+        // 반환값: 이번 호출에서 종료한 세션 수
+        size_t update(TimePoint now);
+
+        size_t getWatchedCount() const { return m_wheel.size(); }
+        uint64_t getReapedCount() const { return m_reapedCount; }
+
+    private:
+        SessionManager& m_sessionManager;
+        std::chrono::milliseconds m_idleTimeout;
+        size_t m_reapBatchSize;
+        core::TimingWheel m_wheel;
+        std::vector<core::TimingWheel::Key> m_expiredKeys;
+        std::deque<SessionId> m_reapQueue; // 종료 대기 중인 유휴 세션
+        uint64_t m_reapedCount = 0;
+    };
+}
@@ -0,0 +1,315 @@
+﻿#include "Loopback.h"
+#include "Session.h"
+#include "Event.h"
+#include <cstring>
+
+namespace net
+{
+    LoopbackPipe::LoopbackPipe(size_t capacity)
+    {
+        assert(0 < capacity);
+
+        m_capacity = 1;
+        while (m_capacity < capacity)
+        {
+            m_capacity <<= 1;
+        }
+
+        m_mask = m_capacity - 1;
+        m_buffer = std::make_unique<uint8_t[]>(m_capacity);
+    }
+
+    size_t LoopbackPipe::read(uint8_t* data, size_t size)
+    {
+        const size_t readPos = m_readPos.load(std::memory_order_relaxed);
+        const size_t readSize = std::min(size, getReadableSize());
+        if (readSize == 0)
+        {
+            return 0;
+        }
+
+        // 링 버퍼 끝에서 나뉘면 두 번에 나눠 복사
+        const size_t offset = readPos & m_mask;
+        const size_t firstSize = std::min(readSize, m_capacity - offset);
+        std::memcpy(data, m_buffer.get() + offset, firstSize);
+        std::memcpy(data + firstSize, m_buffer.get(), readSize - firstSize);
+
+        m_readPos.store(readPos + readSize);
+        wake(m_writerWaiting, m_writeWaker);
+
+        return readSize;
+    }
+
+    size_t LoopbackPipe::write(const uint8_t* data, size_t size)
+    {
+        const size_t writePos = m_writePos.load(std::memory_order_relaxed);
+        const size_t writeSize = std::min(size, getWritableSize());
+        if (writeSize == 0)
+        {
+            return 0;
+        }
+
+        const size_t offset = writePos & m_mask;
+        const size_t firstSize = std::min(writeSize, m_capacity - offset);
+        std::memcpy(m_buffer.get() + offset, data, firstSize);
+        std::memcpy(m_buffer.get(), data + firstSize, writeSize - firstSize);
+
+        m_writePos.store(writePos + writeSize);
+        wake(m_readerWaiting, m_readWaker);
+
+        return writeSize;
+    }
+
+    bool LoopbackPipe::waitReadable(Waker&& waker)
+    {
+        m_readWaker = std::move(waker);
+        m_readerWaiting.store(true);
+
+        // 대기 표시 이후에 다시 확인해야 생산자의 쓰기를 놓치지 않는다
+        if ((getReadableSize() == 0) && !isClosed())
+        {
+            return true;
+        }
+
+        if (m_readerWaiting.exchange(false))
+        {
+            m_readWaker = nullptr;
+            return false;
+        }
+
+        // 생산자가 이미 깨우는 중
+        return true;
+    }
+
+    bool LoopbackPipe::waitWritable(Waker&& waker)
+    {
+        m_writeWaker = std::move(waker);
+        m_writerWaiting.store(true);
+
+        if ((getWritableSize() == 0) && !isClosed())
+        {
+            return true;
+        }
+
+        if (m_writerWaiting.exchange(false))
+        {
+            m_writeWaker = nullptr;
+            return false;
+        }
+
+        return true;
+    }
+
+    void LoopbackPipe::close()
+    {
+        m_closed.store(true);
+
+        wake(m_readerWaiting, m_readWaker);
+        wake(m_writerWaiting, m_writeWaker);
+    }
+
+    void LoopbackPipe::wake(std::atomic<bool>& waiting, Waker& waker)
+    {
+        // 대기 중일 때만 비싼 교환 연산을 수행하고, 교환에 성공한 한 쪽만 콜백을 호출
+        if (waiting.load() && waiting.exchange(false))
+        {
+            Waker target = std::move(waker);
+            waker = nullptr;
+            target();
+        }
+    }
+
+    LoopbackTransport::LoopbackTransport(asio::io_context& ioContext, std::shared_ptr<LoopbackPipe> inbound, std::shared_ptr<LoopbackPipe> outbound)
+        : m_executor(ioContext.get_executor())
+        , m_inbound(std::move(inbound))
+        , m_outbound(std::move(outbound))
+    {}
+
+    std::pair<SessionTransportPtr, SessionTransportPtr> LoopbackTransport::createPair(
+        asio::io_context& firstContext,
+        asio::io_context& secondContext,
+        size_t pipeCapacity)
+    {
+        auto firstToSecond = std::make_shared<LoopbackPipe>(pipeCapacity);
+        auto secondToFirst = std::make_shared<LoopbackPipe>(pipeCapacity);
+
+        return {
+            std::make_unique<LoopbackTransport>(firstContext, secondToFirst, firstToSecond),
+            std::make_unique<LoopbackTransport>(secondContext, firstToSecond, secondToFirst) };
+    }
+
+    void LoopbackTransport::asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer)
+    {
+        m_readBuffer = buffer;
+        tryRead(session);
+    }
+
+    void LoopbackTransport::asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers)
+    {
+        assert(m_writeBuffers == nullptr);
+
+        m_writeBuffers = &buffers;
+        m_writeIndex = 0;
+        m_writeOffset = 0;
+        m_bytesWritten = 0;
+        tryWrite(session);
+    }
+
+    void LoopbackTransport::close(asio::error_code& error)
+    {
+        // 파이프 닫기는 실패하지 않는다
+        error.clear();
+        m_closed = true;
+
+        // 대기 중인 자신의 작업은 취소되고, 상대는 남은 데이터를 읽은 뒤 eof를 받는다
+        m_inbound->close();
+        m_outbound->close();
+    }
+
+    void LoopbackTransport::tryRead(const SessionPtr& session)
+    {
+        asio::error_code error;
+        size_t bytesRead = 0;
+
+        while (!m_closed)
+        {
+            bytesRead = m_inbound->read(static_cast<uint8_t*>(m_readBuffer.data()), m_readBuffer.size());
+            if (0 < bytesRead)
+            {
+                break;
+            }
+
+            if (m_inbound->isClosed())
+            {
+                // 닫히기 직전에 쓴 데이터가 남아 있을 수 있으므로 한 번 더 읽는다
+                bytesRead = m_inbound->read(static_cast<uint8_t*>(m_readBuffer.data()), m_readBuffer.size());
+                if (bytesRead == 0)
+                {
+                    error = asio::error::eof;
+                }
+                break;
+            }
+
+            const bool waiting = m_inbound->waitReadable(
+                [this, session]()
+                {
+                    asio::post(
+                        getSessionExecutor(session),
+                        [this, session]()
+                        {
+                            tryRead(session);
+                        });
+                });
+
+            if (waiting)
+            {
+                return;
+            }
+        }
+
+        if (m_closed)
+        {
+            error = asio::error::operation_aborted;
+            bytesRead = 0;
+        }
+
+        // 소켓과 마찬가지로 완료 핸들러는 세션의 실행기에 post
+        asio::post(
+            getSessionExecutor(session),
+            [session, error, bytesRead]()
+            {
+                completeRead(session, error, bytesRead);
+            });
+    }
+
+    void LoopbackTransport::tryWrite(const SessionPtr& session)
+    {
+        assert(m_writeBuffers);
+        const std::vector<asio::const_buffer>& buffers = *m_writeBuffers;
+
+        while (!m_closed && !m_outbound->isClosed() && (m_writeIndex < buffers.size()))
+        {
+            const asio::const_buffer& buffer = buffers[m_writeIndex];
+            const size_t written = m_outbound->write(
+                static_cast<const uint8_t*>(buffer.data()) + m_writeOffset,
+                buffer.size() - m_writeOffset);
+
+            m_writeOffset += written;
+            m_bytesWritten += written;
+
+            if (m_writeOffset == buffer.size())
+            {
+                ++m_writeIndex;
+                m_writeOffset = 0;
+                continue;
+            }
+
+            if (written != 0)
+            {
+                continue;
+            }
+
+            // 파이프가 가득 차면 상대가 읽을 때까지 대기
+            const bool waiting = m_outbound->waitWritable(
+                [this, session]()
+                {
+                    asio::post(
+                        getSessionExecutor(session),
+                        [this, session]()
+                        {
+                            tryWrite(session);
+                        });
+                });
+
+            if (waiting)
+            {
+                return;
+            }
+        }
+
+        asio::error_code error;
+        if (m_closed)
+        {
+            error = asio::error::operation_aborted;
+        }
+        else if (m_writeIndex < buffers.size())
+        {
+            // 상대가 먼저 연결을 닫음
+            error = asio::error::connection_reset;
+        }
+
+        const size_t bytesWritten = m_bytesWritten;
+        m_writeBuffers = nullptr;
+
+        asio::post(
+            getSessionExecutor(session),
+            [session, error, bytesWritten]()
+            {
+                completeWrite(session, error, bytesWritten);
+            });
+    }
+
+    LoopbackConnector::LoopbackConnector(
+        IoThreadPool& ioThreadPool,
+        ServiceEventQueue& eventQueue,
+        SessionFactory sessionFactory,
+        size_t pipeCapacity)
+        : m_ioThreadPool(ioThreadPool)
+        , m_eventQueue(eventQueue)
+        , m_sessionFactory(std::move(sessionFactory))
+        , m_pipeCapacity(pipeCapacity)
+    {}
+
+    SessionTransportPtr LoopbackConnector::connect(asio::io_context& clientContext)
+    {
+        // 수락 스레드가 없으므로 서버 쪽 세션의 io_context는 IoThreadPool의 배정 정책으로 고른다 (부하에 반영됨)
+        asio::io_context& serverContext = m_ioThreadPool.acquireSessionContext();
+
+        auto [serverTransport, clientTransport] = LoopbackTransport::createPair(serverContext, clientContext, m_pipeCapacity);
+
+        ServiceEventPtr event = std::make_shared<ServiceAcceptEvent>(m_sessionFactory(std::move(serverTransport)));
+        m_eventQueue.push(std::move(event));
+
+        return std::move(clientTransport);
+    }
+}
@@ -0,0 +1,129 @@
+﻿#pragma once
+
+#include <asio.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "Transport.h"
+#include "Service.h"
+#include "Thread.h"
+
+namespace net
+{
+    // 한 방향 바이트 파이프 (단일 생산자 / 단일 소비자 링 버퍼)
+    // 읽기와 쓰기는 잠금 없이 진행하고, 비어 있거나 가득 찼을 때만 상대 쪽이 깨워 줄 콜백을 등록한다
+    class LoopbackPipe
+    {
+    public:
+        using Waker = std::function<void()>;
+
+    public:
+        // capacity는 2의 거듭제곱으로 올림
+        explicit LoopbackPipe(size_t capacity);
+
+        LoopbackPipe(const LoopbackPipe&) = delete;
+        LoopbackPipe& operator=(const LoopbackPipe&) = delete;
+
+        // 소비자: 최대 size 바이트를 읽고 읽은 크기 반환
+        size_t read(uint8_t* data, size_t size);
+
+        // 생산자: 최대 size 바이트를 쓰고 쓴 크기 반환
+        size_t write(const uint8_t* data, size_t size);
+
+        // 읽을 데이터(쓸 공간)가 생기거나 파이프가 닫히면 waker를 한 번 호출
+        // 등록하는 사이에 이미 조건이 만족됐으면 등록하지 않고 false 반환 (호출한 쪽에서 바로 다시 시도)
+        bool waitReadable(Waker&& waker);
+        bool waitWritable(Waker&& waker);
+
+        // 어느 쪽에서든 호출할 수 있으며 대기 중인 양쪽을 모두 깨운다
+        void close();
+        bool isClosed() const { return m_closed.load(); }
+
+    private:
+        size_t getReadableSize() const { return m_writePos.load() - m_readPos.load(std::memory_order_relaxed); }
+        size_t getWritableSize() const { return m_capacity - (m_writePos.load(std::memory_order_relaxed) - m_readPos.load()); }
+
+        static void wake(std::atomic<bool>& waiting, Waker& waker);
+
+    private:
+        std::unique_ptr<uint8_t[]> m_buffer;
+        size_t m_capacity = 0;
+        size_t m_mask = 0;
+
+        // 누적 읽기/쓰기 위치 (생산자와 소비자가 서로 다른 캐시 라인에 기록)
+        alignas(64) std::atomic<size_t> m_readPos = 0;
+        alignas(64) std::atomic<size_t> m_writePos = 0;
+
+        alignas(64) std::atomic<bool> m_closed = false;
+        std::atomic<bool> m_readerWaiting = false;
+        std::atomic<bool> m_writerWaiting = false;
+        Waker m_readWaker;
+        Waker m_writeWaker;
+    };
+
+    // LoopbackPipe 한 쌍으로 연결된 프로세스 내부 전송 계층
+    // 커널을 거치지 않으므로 세션 이후 파이프라인(이벤트 큐, 메시지 큐, 디스패처, 직렬화)의 비용만 따로 측정할 수 있다
+    class LoopbackTransport final
+        : public SessionTransport
+    {
+    public:
+        static constexpr size_t DefaultPipeCapacity = 256 * 1024;
+
+    public:
+        LoopbackTransport(asio::io_context& ioContext, std::shared_ptr<LoopbackPipe> inbound, std::shared_ptr<LoopbackPipe> outbound);
+
+        // 서로 연결된 전송 계층 한 쌍 생성 (각각 지정한 io_context에서 완료 처리)
+        static std::pair<SessionTransportPtr, SessionTransportPtr> createPair(
+            asio::io_context& firstContext,
+            asio::io_context& secondContext,
+            size_t pipeCapacity = DefaultPipeCapacity);
+
+        virtual asio::any_io_executor getExecutor() override { return m_executor; }
+
+        virtual void asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer) override;
+        virtual void asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers) override;
+
+        virtual void close(asio::error_code& error) override;
+        virtual bool isOpen() const override { return !m_closed; }
+
+    private:
+        void tryRead(const SessionPtr& session);
+        void tryWrite(const SessionPtr& session);
+
+    private:
+        asio::io_context::executor_type m_executor;
+        std::shared_ptr<LoopbackPipe> m_inbound;
+        std::shared_ptr<LoopbackPipe> m_outbound;
+        bool m_closed = false;
+
+        // 진행 중인 읽기 (세션의 실행기에서만 사용)
+        asio::mutable_buffer m_readBuffer;
+
+        // 진행 중인 쓰기 (세션의 실행기에서만 사용)
+        const std::vector<asio::const_buffer>* m_writeBuffers = nullptr;
+        size_t m_writeIndex = 0;
+        size_t m_writeOffset = 0;
+        size_t m_bytesWritten = 0;
+    };
+
+    // 같은 프로세스의 서버에 LoopbackTransport로 연결
+    // 서버 쪽 세션은 SessionFactory로 생성해 ServiceAcceptEvent로 전달하고, 클라이언트 쪽 전송 계층을 반환한다
+    class LoopbackConnector
+    {
+    public:
+        LoopbackConnector(
+            IoThreadPool& ioThreadPool,
+            ServiceEventQueue& eventQueue,
+            SessionFactory sessionFactory,
+            size_t pipeCapacity = LoopbackTransport::DefaultPipeCapacity);
+
+        // 어느 스레드에서든 호출 가능 (반환한 전송 계층은 clientContext에서 완료 처리)
+        SessionTransportPtr connect(asio::io_context& clientContext);
+
+    private:
+        IoThreadPool& m_ioThreadPool;
+        ServiceEventQueue& m_eventQueue;
+        SessionFactory m_sessionFactory;
+        size_t m_pipeCapacity;
+    };
+}
@@ -1,30 +1,83 @@
 ﻿#pragma once
 
+#include <cstdint>
+#include <limits>
+
 namespace net
 {
     using PacketId = uint16_t;
     using PacketSize = uint16_t;
 
+    // 한 패킷의 최대 크기 (헤더 포함)
+    // 수신 버퍼가 한 번에 읽는 크기 이하여야 부분 수신된 패킷이 항상 버퍼 안에 들어간다
+    constexpr size_t MaxPacketSize = 4096;
+
+    // 조각 패킷으로 나눠 보낼 수 있는 메시지의 최대 크기 (재조립 버퍼 크기 제한)
+    constexpr size_t MaxMessageSize = 16 * 1024 * 1024;
+
+    // MaxPacketSize보다 큰 메시지를 나눠 보내는 조각 패킷 ID (메시지 타입과 겹치지 않도록 최댓값 근처를 예약)
+    constexpr PacketId FragmentBeginPacketId = 0xFFFE;  // 첫 조각: FragmentHeader + 데이터
+    constexpr PacketId FragmentPacketId = 0xFFFF;       // 이어지는 조각: 데이터
+
+    // 압축된 메시지 패킷 ID (CompressionHeader + 압축 데이터, 크면 다시 조각 패킷으로 나뉨)
+    constexpr PacketId CompressedPacketId = 0xFFFD;
+
+    enum class CompressionCodec : uint8_t
+    {
+        None = 0,
+        Lz4 = 1,
+        Zstd = 2,
+    };
+
 #pragma pack(push, 1) // 1바이트 정렬로 패킹
     struct PacketHeader
     {
         PacketSize size; // 패킷 크기 (헤더 포함)
         PacketId id;   // 패킷 식별 ID
     };
+
+    // 첫 조각 패킷의 PacketHeader 바로 뒤에 위치
+    struct FragmentHeader
+    {
+        uint32_t messageSize;   // 모든 조각의 데이터를 합친 크기
+        PacketId id;            // 재조립한 메시지의 패킷 ID
+    };
+
+    // 압축 패킷의 PacketHeader 바로 뒤에 위치
+    struct CompressionHeader
+    {
+        uint32_t originalSize;  // 압축을 풀었을 때의 크기
+        PacketId id;            // 압축을 푼 메시지의 패킷 ID
+        CompressionCodec codec;
+    };
 #pragma pack(pop) // 원래 정렬로 되돌리기
 
+    static_assert(MaxPacketSize <= std::numeric_limits<PacketSize>::max(), "MaxPacketSize must fit in PacketSize");
+
+    // 첫 조각과 이어지는 조각이 담을 수 있는 데이터 크기
+    constexpr size_t FirstFragmentDataSize = MaxPacketSize - sizeof(PacketHeader) - sizeof(FragmentHeader);
+    constexpr size_t FragmentDataSize = MaxPacketSize - sizeof(PacketHeader);
+
     struct PacketView
     {
-        const PacketHeader* header = nullptr;
+        PacketId id = 0;
         const uint8_t* payload = nullptr;
+        size_t payloadSize = 0; // 조각 패킷으로 받은 메시지는 재조립한 전체 크기
 
         PacketView() = default;
 
         PacketView(const uint8_t* packet)
-            : header(reinterpret_cast<const PacketHeader*>(packet))
+            : id(reinterpret_cast<const PacketHeader*>(packet)->id)
             , payload(packet + sizeof(PacketHeader))
+            , payloadSize(reinterpret_cast<const PacketHeader*>(packet)->size - sizeof(PacketHeader))
+        {}
+
+        PacketView(PacketId id, const uint8_t* payload, size_t payloadSize)
+            : id(id)
+            , payload(payload)
+            , payloadSize(payloadSize)
         {}
 
-        bool isValid() const { return header && payload; }
+        bool isValid() const { return payload != nullptr; }
     };
 }
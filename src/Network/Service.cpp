@@ -1,9 +1,106 @@
 ﻿#include "Service.h"
 #include "Session.h"
 #include "Event.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <utility>
 
 namespace net
 {
+    namespace
+    {
+#if defined(SO_REUSEPORT)
+        using ReusePortOption = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+        constexpr bool IsReusePortSupported = true;
+#else
+        constexpr bool IsReusePortSupported = false;
+#endif // SO_REUSEPORT
+
+        TransportBackend getDefaultTransportBackend()
+        {
+            return isTransportBackendAvailable(TransportBackend::Uring) ? TransportBackend::Uring : TransportBackend::Socket;
+        }
+
+        const char* toString(TransportBackend backend)
+        {
+            return (backend == TransportBackend::Uring) ? "io_uring" : "socket";
+        }
+
+        // 로그용 엔드포인트 문자열 (TCP가 아니면 주소 없이 표시)
+        std::string toString(const StreamProtocol::endpoint& endpoint)
+        {
+            const int family = endpoint.protocol().family();
+            if ((family != AF_INET) && (family != AF_INET6))
+            {
+                return "local";
+            }
+
+            asio::ip::tcp::endpoint tcpEndpoint;
+            std::memcpy(tcpEndpoint.data(), endpoint.data(), endpoint.size());
+
+            return tcpEndpoint.address().to_string() + ":" + std::to_string(tcpEndpoint.port());
+        }
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+        // 이전 프로세스가 비정상 종료해 남긴 소켓 파일만 지운다
+        // 소켓 파일이 아니거나 연결을 받는 프로세스가 있으면 그대로 두고, 이어지는 바인딩이 실패한다
+        void removeStaleSocketFile(const std::string& path)
+        {
+            std::error_code fileError;
+            const std::filesystem::file_status status = std::filesystem::symlink_status(path, fileError);
+            if (!std::filesystem::exists(status))
+            {
+                return;
+            }
+
+            if (status.type() != std::filesystem::file_type::socket)
+            {
+                spdlog::error("[ServerService] 소켓 파일이 아니므로 지우지 않음: {}", path);
+                return;
+            }
+
+            asio::io_context ioContext;
+            asio::local::stream_protocol::socket probe(ioContext);
+            asio::error_code error;
+            probe.connect(asio::local::stream_protocol::endpoint(path), error);
+            if (!error)
+            {
+                spdlog::error("[ServerService] 다른 프로세스가 사용 중인 소켓 파일: {}", path);
+                return;
+            }
+
+            if (error != asio::error::connection_refused)
+            {
+                spdlog::error("[ServerService] 소켓 파일 확인 실패: {} ({})", path, error.message());
+                return;
+            }
+
+            spdlog::info("[ServerService] 남아 있던 소켓 파일 제거: {}", path);
+            std::filesystem::remove(path, fileError);
+        }
+#endif // ASIO_HAS_LOCAL_SOCKETS
+
+        // 프로세스나 시스템의 디스크립터, 커널 버퍼가 모자란 수락 에러 (연결은 리슨 큐에 남아 있다가 다시 수락된다)
+        bool isTransientAcceptError(const asio::error_code& error)
+        {
+            switch (error.value())
+            {
+            case asio::error::no_descriptors:   // EMFILE
+#if !defined(_WIN32)
+            case ENFILE:
+#endif // !_WIN32
+            case asio::error::no_buffer_space:  // ENOBUFS
+            case asio::error::no_memory:        // ENOMEM
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
     Service::Service(asio::io_context& ioContext, ServiceEventQueue& eventQueue)
         : m_running(false)
         , m_strand(asio::make_strand(ioContext))
@@ -36,19 +133,85 @@ namespace net
             });
     }
 
-    ServerService::ServerService(asio::io_context& ioContext, ServiceEventQueue& eventQueue, uint16_t port)
-        : Service(ioContext, eventQueue)
-        , m_acceptor(ioContext, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port))
-    {}
+    ServerService::ServerService(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, uint16_t port, SessionFactory sessionFactory)
+        : Service(ioThreadPool.getContext(), eventQueue)
+        , m_ioThreadPool(ioThreadPool)
+        , m_sessionFactory(std::move(sessionFactory))
+        , m_endpoint(asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port))
+        , m_endpointName(std::to_string(port))
+        , m_transportBackend(getDefaultTransportBackend())
+    {
+        assert(m_sessionFactory);
+
+        // SO_REUSEPORT acceptor는 IO 스레드마다 전용 io_context가 있을 때만 스레드별로 연다 (공유 io_context면 모두 같은 곳에 놓여 나눌 의미가 없다)
+        // 그 밖에는 acceptor 하나에 여러 accept를 걸어 두고, 수락할 때 세션의 io_context를 골라 분산한다
+        const bool useReusePort = IsReusePortSupported && (ioThreadPool.getThreadModel() == IoThreadModel::ContextPerThread);
+        const size_t acceptorCount = useReusePort ? ioThreadPool.getThreadCount() : 1;
 
-    ServerServicePtr ServerService::createInstance(asio::io_context& ioContext, ServiceEventQueue& eventQueue, uint16_t port)
+        m_acceptors.reserve(acceptorCount);
+        for (size_t i = 0; i < acceptorCount; ++i)
+        {
+            m_acceptors.push_back(std::make_unique<Acceptor>(ioThreadPool.getThreadContext(i)));
+            openAcceptor(*m_acceptors.back(), (acceptorCount > 1));
+        }
+    }
+
+    ServerServicePtr ServerService::createInstance(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, uint16_t port, SessionFactory sessionFactory)
     {
-        auto service = std::make_shared<ServerService>(ioContext, eventQueue, port);
+        auto service = std::make_shared<ServerService>(ioThreadPool, eventQueue, port, std::move(sessionFactory));
         service->asyncWaitForStopSignals();
 
         return service;
     }
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+    ServerService::ServerService(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, const std::string& localPath, SessionFactory sessionFactory)
+        : Service(ioThreadPool.getContext(), eventQueue)
+        , m_ioThreadPool(ioThreadPool)
+        , m_sessionFactory(std::move(sessionFactory))
+        , m_endpoint(asio::local::stream_protocol::endpoint(localPath))
+        , m_localPath(localPath)
+        , m_endpointName(localPath)
+        , m_transportBackend(getDefaultTransportBackend())
+    {
+        assert(m_sessionFactory);
+        assert(!m_localPath.empty());
+
+        // 이전 프로세스가 남긴 소켓 파일이 있으면 바인딩에 실패한다
+        removeStaleSocketFile(m_localPath);
+
+        m_acceptors.push_back(std::make_unique<Acceptor>(ioThreadPool.getThreadContext(0)));
+        openAcceptor(*m_acceptors.back(), false);
+    }
+
+    ServerServicePtr ServerService::createInstance(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, const std::string& localPath, SessionFactory sessionFactory)
+    {
+        auto service = std::make_shared<ServerService>(ioThreadPool, eventQueue, localPath, std::move(sessionFactory));
+        service->asyncWaitForStopSignals();
+
+        return service;
+    }
+#endif // ASIO_HAS_LOCAL_SOCKETS
+
+    void ServerService::openAcceptor(Acceptor& acceptor, bool reusePort)
+    {
+        acceptor.acceptor.open(m_endpoint.protocol());
+        if (m_localPath.empty())
+        {
+            acceptor.acceptor.set_option(asio::socket_base::reuse_address(true));
+        }
+#if defined(SO_REUSEPORT)
+        if (reusePort)
+        {
+            acceptor.acceptor.set_option(ReusePortOption(true));
+        }
+#else
+        (void)reusePort;
+#endif // SO_REUSEPORT
+        acceptor.acceptor.bind(m_endpoint);
+        acceptor.acceptor.listen(asio::socket_base::max_listen_connections);
+    }
+
     void ServerService::start()
     {
         if (m_running.exchange(true))
@@ -57,14 +220,41 @@ namespace net
             return;
         }
 
-        spdlog::info("[ServerService] 서비스 시작: {}", m_acceptor.local_endpoint().port());
+        spdlog::info("[ServerService] 서비스 시작: {} (acceptor {}개, {})", m_endpointName, m_acceptors.size(), toString(m_transportBackend));
 
-        asio::post(
-            m_strand,
-            [this, self = shared_from_this()]()
-            {
-                asyncAccept();
-            });
+        for (auto& acceptor : m_acceptors)
+        {
+            asio::post(
+                acceptor->strand,
+                [this, self = shared_from_this(), &target = *acceptor]()
+                {
+#if defined(BYTEBORNE_HAS_IO_URING)
+                    if (m_transportBackend == TransportBackend::Uring)
+                    {
+                        startUringAccept(target);
+                        return;
+                    }
+#endif // BYTEBORNE_HAS_IO_URING
+
+                    for (size_t i = 0; i < PendingAcceptCount; ++i)
+                    {
+                        asyncAccept(target);
+                    }
+                });
+        }
+    }
+
+    void ServerService::setTransportBackend(TransportBackend backend)
+    {
+        assert(!m_running.load());
+
+        if (!isTransportBackendAvailable(backend))
+        {
+            spdlog::warn("[ServerService] {} 백엔드를 사용할 수 없어 socket 백엔드로 대체: {}", toString(backend), m_endpointName);
+            backend = TransportBackend::Socket;
+        }
+
+        m_transportBackend = backend;
     }
 
     void ServerService::stop()
@@ -85,33 +275,87 @@ namespace net
             });
     }
 
-    void ServerService::asyncAccept()
+    void ServerService::asyncAccept(Acceptor& acceptor)
     {
         if (!m_running.load())
         {
             return;
         }
 
-        m_acceptor.async_accept(
+        if (m_acceptors.size() == 1)
+        {
+            // acceptor가 하나뿐이면 세션을 배정할 io_context에 바로 수락해 세션을 IO 스레드에 분산
+            asio::io_context& sessionContext = m_ioThreadPool.acquireSessionContext();
+
+            acceptor.acceptor.async_accept(
+                sessionContext,
+                asio::bind_executor(
+                    acceptor.strand,
+                    [this, self = shared_from_this(), &acceptor, &sessionContext]
+                    (const asio::error_code& error, StreamProtocol::socket socket)
+                    {
+                        if (error)
+                        {
+                            // 배정한 io_context에 세션이 생기지 않았으므로 부하에서 제외
+                            m_ioThreadPool.releaseSessionContext(sessionContext);
+                        }
+
+                        onAccepted(error, std::move(socket), acceptor);
+                    }));
+            return;
+        }
+
+        // SO_REUSEPORT acceptor의 소켓은 acceptor와 같은 io_context에서 생성되어 수락한 스레드를 벗어나지 않는다
+        acceptor.acceptor.async_accept(
             asio::bind_executor(
-                m_strand,
-                [this, self = shared_from_this()]
-                (const asio::error_code& error, asio::ip::tcp::socket socket)
+                acceptor.strand,
+                [this, self = shared_from_this(), &acceptor]
+                (const asio::error_code& error, StreamProtocol::socket socket)
                 {
-                    onAccepted(error, std::move(socket));
+                    if (!error)
+                    {
+                        m_ioThreadPool.retainSessionContext(asio::query(socket.get_executor(), asio::execution::context));
+                    }
+
+                    onAccepted(error, std::move(socket), acceptor);
                 }));
     }
 
-    void ServerService::onAccepted(const asio::error_code& error, asio::ip::tcp::socket&& socket)
+    void ServerService::onAccepted(const asio::error_code& error, StreamProtocol::socket&& socket, Acceptor& acceptor)
     {
         if (!error)
         {
-            const auto& remoteEndpoint = socket.remote_endpoint();
-            spdlog::debug("[ServerService] 클라이언트 수락: {}:{}", remoteEndpoint.address().to_string(), remoteEndpoint.port());
+            acceptor.retryDelay = std::chrono::milliseconds(0);
 
-            // 이벤트 큐에 accept 이벤트 추가
-            ServiceEventPtr event = std::make_shared<ServiceAcceptEvent>(std::move(socket));
-            m_eventQueue.push(std::move(event));
+            asio::error_code endpointError;
+            const auto remoteEndpoint = socket.remote_endpoint(endpointError);
+            if (!endpointError)
+            {
+                spdlog::debug("[ServerService] 클라이언트 수락: {} ({})", toString(remoteEndpoint), m_endpointName);
+            }
+
+            if (m_acceptors.size() == 1)
+            {
+                // 완료 핸들러는 acceptor의 strand(첫 io_context)에서 실행되므로, 세션 생성은 배정한 io_context로 넘기고 acceptor는 바로 다음 연결을 받는다
+                asio::post(
+                    socket.get_executor(),
+                    [this, self = shared_from_this(), socket = std::move(socket)]() mutable
+                    {
+                        createSession(std::make_unique<SocketTransport>(std::move(socket)));
+                    });
+            }
+            else
+            {
+                // SO_REUSEPORT acceptor는 세션과 같은 io_context에서 실행 중
+                createSession(std::make_unique<SocketTransport>(std::move(socket)));
+            }
+        }
+        else if (isTransientAcceptError(error))
+        {
+            // 바로 다시 걸면 같은 에러로 계속 실패하므로 대기가 끝난 뒤에 건다
+            ++acceptor.pausedAccepts;
+            pauseAccept(error, acceptor);
+            return;
         }
         else
         {
@@ -119,7 +363,158 @@ namespace net
         }
 
         // 다음 accept를 위해 다시 호출
-        asyncAccept();
+        asyncAccept(acceptor);
+    }
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+    void ServerService::startUringAccept(Acceptor& acceptor)
+    {
+        if (!m_running.load())
+        {
+            return;
+        }
+
+        // 리스닝 소켓 하나에 multishot accept 하나면 수락할 때마다 다시 걸 필요가 없다
+        auto uringAcceptor = std::make_shared<UringAcceptor>(
+            acceptor.ioContext,
+            acceptor.acceptor.native_handle(),
+            acceptor.strand,
+            [this, self = shared_from_this(), &acceptor]
+            (const asio::error_code& error, int fd)
+            {
+                onUringAccepted(error, fd, acceptor);
+            });
+        uringAcceptor->start();
+        acceptor.uringAcceptor = uringAcceptor;
+    }
+
+    void ServerService::onUringAccepted(const asio::error_code& error, int fd, Acceptor& acceptor)
+    {
+        if (isTransientAcceptError(error))
+        {
+            // multishot accept가 곧바로 다시 걸려 같은 에러로 계속 실패하지 않도록 멈추고, 대기가 끝나면 새로 건다
+            if (auto uringAcceptor = acceptor.uringAcceptor.lock())
+            {
+                uringAcceptor->stop();
+            }
+            pauseAccept(error, acceptor);
+            return;
+        }
+
+        if (error)
+        {
+            handleError(error);
+            return;
+        }
+
+        acceptor.retryDelay = std::chrono::milliseconds(0);
+
+        if (m_acceptors.size() == 1)
+        {
+            // 세션의 io_context를 고르고 그 io_context의 링에서 주고받는 전송 계층을 만들어 넘긴다
+            asio::io_context& sessionContext = m_ioThreadPool.acquireSessionContext();
+            SessionTransportPtr transport = std::make_unique<UringTransport>(sessionContext, fd);
+
+            asio::post(
+                sessionContext,
+                [this, self = shared_from_this(), transport = std::move(transport)]() mutable
+                {
+                    createSession(std::move(transport));
+                });
+            return;
+        }
+
+        // SO_REUSEPORT acceptor는 세션과 같은 io_context에서 실행 중
+        m_ioThreadPool.retainSessionContext(acceptor.ioContext);
+        createSession(std::make_unique<UringTransport>(acceptor.ioContext, fd));
+    }
+#endif // BYTEBORNE_HAS_IO_URING
+
+    void ServerService::pauseAccept(const asio::error_code& error, Acceptor& acceptor)
+    {
+        if (acceptor.retryPending)
+        {
+            return;
+        }
+
+        acceptor.retryPending = true;
+        acceptor.retryDelay = std::clamp(acceptor.retryDelay * 2, AcceptRetryInitialDelay, AcceptRetryMaxDelay);
+
+        spdlog::warn("[ServerService] 수락 실패로 {}ms 뒤 다시 수락: {} ({})", acceptor.retryDelay.count(), error.message(), m_endpointName);
+
+        acceptor.retryTimer.expires_after(acceptor.retryDelay);
+        acceptor.retryTimer.async_wait(
+            asio::bind_executor(
+                acceptor.strand,
+                [this, self = shared_from_this(), &acceptor](const asio::error_code& error)
+                {
+                    acceptor.retryPending = false;
+                    if (!error)
+                    {
+                        resumeAccept(acceptor);
+                    }
+                }));
+    }
+
+    void ServerService::resumeAccept(Acceptor& acceptor)
+    {
+        if (!m_running.load() || !acceptor.acceptor.is_open())
+        {
+            return;
+        }
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+        if (m_transportBackend == TransportBackend::Uring)
+        {
+            startUringAccept(acceptor);
+            return;
+        }
+#endif // BYTEBORNE_HAS_IO_URING
+
+        const size_t pausedAccepts = std::exchange(acceptor.pausedAccepts, 0);
+        for (size_t i = 0; i < pausedAccepts; ++i)
+        {
+            asyncAccept(acceptor);
+        }
+    }
+
+    void ServerService::createSession(SessionTransportPtr&& transport)
+    {
+        // 세션은 배정한 io_context의 IO 스레드에서 생성하고 등록과 시작은 메인 스레드에 맡긴다
+        ServiceEventPtr event = std::make_shared<ServiceAcceptEvent>(m_sessionFactory(std::move(transport)));
+        m_eventQueue.push(std::move(event));
+    }
+
+    void ServerService::closeAcceptor(Acceptor& acceptor)
+    {
+        acceptor.retryTimer.cancel();
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+        if (auto uringAcceptor = acceptor.uringAcceptor.lock())
+        {
+            // 취소한 뒤에는 수락한 소켓을 넘기지 않는다
+            uringAcceptor->cancel();
+        }
+#endif // BYTEBORNE_HAS_IO_URING
+
+        if (!acceptor.acceptor.is_open())
+        {
+            return;
+        }
+
+        asio::error_code error;
+
+        acceptor.acceptor.cancel(error);
+        if (error)
+        {
+            handleError(error);
+        }
+
+        acceptor.acceptor.close(error);
+        if (error)
+        {
+            handleError(error);
+        }
     }
 
     void ServerService::handleError(const asio::error_code& error)
@@ -171,19 +566,21 @@ namespace net
             handleError(error);
         }
 
-        if (m_acceptor.is_open())
+        // acceptor는 각자의 strand에서 닫는다
+        for (auto& acceptor : m_acceptors)
         {
-            m_acceptor.cancel(error);
-            if (error)
-            {
-                handleError(error);
-            }
+            asio::post(
+                acceptor->strand,
+                [this, self = shared_from_this(), &target = *acceptor]()
+                {
+                    closeAcceptor(target);
+                });
+        }
 
-            m_acceptor.close(error);
-            if (error)
-            {
-                handleError(error);
-            }
+        if (!m_localPath.empty())
+        {
+            // 더 이상 연결을 받지 않으므로 소켓 파일 제거
+            std::remove(m_localPath.c_str());
         }
 
         // 서비스 이벤트 큐에 close 이벤트 추가
@@ -194,6 +591,7 @@ namespace net
     ClientService::ClientService(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const ResolveTarget& resolveTarget, size_t connectCount)
         : Service(ioContext, eventQueue)
         , m_resolveTarget(resolveTarget)
+        , m_targetName(resolveTarget.host + ":" + resolveTarget.service)
         , m_resolver(ioContext)
     {
         assert(connectCount > 0);
@@ -213,6 +611,31 @@ namespace net
         return service;
     }
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+    ClientService::ClientService(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const std::string& localPath, size_t connectCount)
+        : Service(ioContext, eventQueue)
+        , m_targetName(localPath)
+        , m_resolver(ioContext)
+        , m_endpoints{ asio::local::stream_protocol::endpoint(localPath) }
+    {
+        assert(connectCount > 0);
+
+        m_sockets.reserve(connectCount);
+        for (size_t i = 0; i < connectCount; ++i)
+        {
+            m_sockets.emplace_back(ioContext);
+        }
+    }
+
+    ClientServicePtr ClientService::createInstance(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const std::string& localPath, size_t connectCount)
+    {
+        auto service = std::make_shared<ClientService>(ioContext, eventQueue, localPath, connectCount);
+        service->asyncWaitForStopSignals();
+
+        return service;
+    }
+#endif // ASIO_HAS_LOCAL_SOCKETS
+
     void ClientService::start()
     {
         if (m_running.exchange(true))
@@ -221,13 +644,20 @@ namespace net
             return;
         }
 
-        spdlog::info("[ClientService] 서비스 시작");
+        spdlog::info("[ClientService] 서비스 시작: {}", m_targetName);
 
         asio::post(
             m_strand,
             [this, self = shared_from_this()]()
             {
-                asyncResolve();
+                if (m_endpoints.empty())
+                {
+                    asyncResolve();
+                }
+                else
+                {
+                    asyncConnectAll();
+                }
             });
     }
 
@@ -271,19 +701,16 @@ namespace net
     {
         if (!error)
         {
+            m_endpoints.clear();
             for (const auto& entry : results)
             {
                 const auto& endpoint = entry.endpoint();
                 spdlog::debug("[ClientService] 엔드포인트: {}:{}", endpoint.address().to_string(), endpoint.port());
-            }
-
-            m_resolveResults = results;
 
-            // 비동기 연결 시작
-            for (size_t i = 0; i < m_sockets.size(); ++i)
-            {
-                asyncConnect(i);
+                m_endpoints.emplace_back(endpoint);
             }
+
+            asyncConnectAll();
         }
         else
         {
@@ -291,6 +718,15 @@ namespace net
         }
     }
 
+    void ClientService::asyncConnectAll()
+    {
+        // 비동기 연결 시작
+        for (size_t i = 0; i < m_sockets.size(); ++i)
+        {
+            asyncConnect(i);
+        }
+    }
+
     void ClientService::asyncConnect(size_t socketIndex)
     {
         if (!m_running.load())
@@ -299,11 +735,11 @@ namespace net
         }
 
         asio::async_connect(
-            m_sockets[socketIndex], m_resolveResults,
+            m_sockets[socketIndex], m_endpoints,
             asio::bind_executor(
                 m_strand,
                 [this, self = shared_from_this(), socketIndex]
-                (const asio::error_code& error, const asio::ip::tcp::endpoint& endpoint)
+                (const asio::error_code& error, const StreamProtocol::endpoint& endpoint)
                 {
                     onConnected(error, socketIndex);
                 }));
@@ -313,7 +749,7 @@ namespace net
     {
         if (!error)
         {
-            spdlog::debug("[ClientService] 서버 연결: {}:{}", m_resolveTarget.host, m_resolveTarget.service);
+            spdlog::debug("[ClientService] 서버 연결: {}", m_targetName);
 
             // 이벤트 큐에 connect 이벤트 추가
             ServiceEventPtr event = std::make_shared<ServiceConnectEvent>(std::move(m_sockets[socketIndex]));
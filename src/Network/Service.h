@@ -1,8 +1,11 @@
 ﻿#pragma once
 
 #include <asio.hpp>
+#include <functional>
 #include "Core/LockQueue.h"
 #include "Thread.h"
+#include "Session.h"
+#include "Uring.h"
 
 namespace net
 {
@@ -10,6 +13,9 @@ namespace net
 
     using ServiceEventQueue = core::LockQueue<std::shared_ptr<struct ServiceEvent>>;
 
+    // 서비스가 사용하는 스트림 소켓은 TCP와 유닉스 도메인 소켓을 모두 담을 수 있는 generic 프로토콜로 다룬다
+    using StreamProtocol = asio::generic::stream_protocol;
+
     class Service
         : public std::enable_shared_from_this<Service>
     {
@@ -35,27 +41,103 @@ namespace net
 
     using ServerServicePtr = std::shared_ptr<class ServerService>;
 
+    // 수락한 연결의 전송 계층으로 세션 생성 (수락한 IO 스레드 등 여러 스레드에서 호출되므로 스레드 안전해야 함)
+    using SessionFactory = std::function<SessionPtr(SessionTransportPtr&& transport)>;
+
     class ServerService
         : public Service
     {
     public:
-        ServerService(asio::io_context& ioContext, ServiceEventQueue& eventQueue, uint16_t port);
+        // acceptor 하나에 동시에 걸어 두는 async_accept 수
+        static constexpr size_t PendingAcceptCount = 4;
+
+        // 디스크립터나 커널 버퍼가 모자라 수락에 실패하면 그 acceptor만 쉬었다가 다시 건다 (연속 실패마다 두 배)
+        static constexpr std::chrono::milliseconds AcceptRetryInitialDelay{ 10 };
+        static constexpr std::chrono::milliseconds AcceptRetryMaxDelay{ 1000 };
+
+    public:
+        // SO_REUSEPORT를 지원하면 IO 스레드마다 같은 포트에 바인딩된 acceptor를 두어 커널이 연결을 분산한다
+        // 수락한 소켓과 세션은 acceptor의 io_context(수락한 스레드)에 그대로 남는다
+        // 지원하지 않으면 acceptor 하나가 IoThreadPool::acquireSessionContext()로 고른 io_context에 소켓을 수락한다
+        // 어느 쪽이든 수락한 세션은 IoThreadPool의 부하에 반영된 상태로 전달되며, 세션이 끝나면 releaseSessionContext()를 호출해야 한다
+        ServerService(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, uint16_t port, SessionFactory sessionFactory);
 
-        static ServerServicePtr createInstance(asio::io_context& ioContext, ServiceEventQueue& eventQueue, uint16_t port);
+        static ServerServicePtr createInstance(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, uint16_t port, SessionFactory sessionFactory);
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+        // 같은 호스트의 프로세스를 위한 유닉스 도메인 소켓 서비스 (acceptor 하나)
+        // 남아 있는 소켓 파일은 연결을 받는 프로세스가 없을 때만 지우고 바인딩한다 (아니면 바인딩 실패로 예외)
+        ServerService(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, const std::string& localPath, SessionFactory sessionFactory);
+
+        static ServerServicePtr createInstance(IoThreadPool& ioThreadPool, ServiceEventQueue& eventQueue, const std::string& localPath, SessionFactory sessionFactory);
+#endif // ASIO_HAS_LOCAL_SOCKETS
         ServerServicePtr getInstance() { return std::static_pointer_cast<ServerService>(shared_from_this()); }
 
         virtual void start() override;
         virtual void stop() override;
 
+        // start() 전에 설정 (기본값은 사용할 수 있으면 Uring), 사용할 수 없는 백엔드면 Socket으로 대체
+        void setTransportBackend(TransportBackend backend);
+        TransportBackend getTransportBackend() const { return m_transportBackend; }
+
     private:
-        void asyncAccept();
-        void onAccepted(const asio::error_code& error, asio::ip::tcp::socket&& socket);
+        struct Acceptor
+        {
+            asio::io_context& ioContext;
+            asio::basic_socket_acceptor<StreamProtocol> acceptor;
+            asio::strand<asio::io_context::executor_type> strand; // SharedContext에서 완료 핸들러 직렬화
+#if defined(BYTEBORNE_HAS_IO_URING)
+            std::weak_ptr<UringAcceptor> uringAcceptor; // Uring 백엔드의 multishot accept (진행 중인 accept가 유지하며, 핸들러가 서비스를 잡고 있으므로 약한 참조)
+#endif // BYTEBORNE_HAS_IO_URING
+
+            // 일시적인 수락 에러 뒤의 대기 (strand에서만 사용)
+            asio::steady_timer retryTimer;
+            std::chrono::milliseconds retryDelay{ 0 };
+            bool retryPending = false;
+            size_t pausedAccepts = 0;   // 대기가 끝나면 다시 걸 async_accept 수
+
+            explicit Acceptor(asio::io_context& ioContext)
+                : ioContext(ioContext)
+                , acceptor(ioContext)
+                , strand(asio::make_strand(ioContext))
+                , retryTimer(ioContext)
+            {}
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+            ~Acceptor()
+            {
+                // 닫기 전에 io_context가 멈췄으면 링의 accept가 리스닝 소켓을 붙잡고 있을 수 있으므로, 리스닝을 멈춰 포트를 바로 푼다
+                if (acceptor.is_open())
+                {
+                    ::shutdown(acceptor.native_handle(), SHUT_RDWR);
+                }
+            }
+#endif // BYTEBORNE_HAS_IO_URING
+        };
+
+        void openAcceptor(Acceptor& acceptor, bool reusePort);
+        void asyncAccept(Acceptor& acceptor);
+        void onAccepted(const asio::error_code& error, StreamProtocol::socket&& socket, Acceptor& acceptor);
+#if defined(BYTEBORNE_HAS_IO_URING)
+        void startUringAccept(Acceptor& acceptor);
+        void onUringAccepted(const asio::error_code& error, int fd, Acceptor& acceptor);
+#endif // BYTEBORNE_HAS_IO_URING
+        void pauseAccept(const asio::error_code& error, Acceptor& acceptor);
+        void resumeAccept(Acceptor& acceptor);
+        void createSession(SessionTransportPtr&& transport);
+        void closeAcceptor(Acceptor& acceptor);
 
         virtual void handleError(const asio::error_code& error) override;
         virtual void close() override;
 
     private:
-        asio::ip::tcp::acceptor m_acceptor;
+        IoThreadPool& m_ioThreadPool;
+        SessionFactory m_sessionFactory;
+        StreamProtocol::endpoint m_endpoint;
+        std::string m_localPath;    // 유닉스 도메인 소켓이면 소켓 파일 경로
+        std::string m_endpointName; // 로그용
+        TransportBackend m_transportBackend;
+        std::vector<std::unique_ptr<Acceptor>> m_acceptors;
     };
 
     using ClientServicePtr = std::shared_ptr<class ClientService>;
@@ -73,6 +155,13 @@ namespace net
         ClientService(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const ResolveTarget& resolveTarget, size_t connectCount);
 
         static ClientServicePtr createInstance(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const ResolveTarget& resolveTarget, size_t connectCount);
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+        // 유닉스 도메인 소켓으로 연결 (주소 해석 없이 바로 연결)
+        ClientService(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const std::string& localPath, size_t connectCount);
+
+        static ClientServicePtr createInstance(asio::io_context& ioContext, ServiceEventQueue& eventQueue, const std::string& localPath, size_t connectCount);
+#endif // ASIO_HAS_LOCAL_SOCKETS
         ClientServicePtr getInstance() { return std::static_pointer_cast<ClientService>(shared_from_this()); }
 
         virtual void start() override;
@@ -81,6 +170,7 @@ namespace net
     private:
         void asyncResolve();
         void onResolved(const asio::error_code& error, const asio::ip::tcp::resolver::results_type& results);
+        void asyncConnectAll();
         void asyncConnect(size_t socketIndex);
         void onConnected(const asio::error_code& error, size_t socketIndex);
 
@@ -89,8 +179,9 @@ namespace net
 
     private:
         ResolveTarget m_resolveTarget;
+        std::string m_targetName;   // 로그용
         asio::ip::tcp::resolver m_resolver;
-        asio::ip::tcp::resolver::results_type m_resolveResults;
-        std::vector<asio::ip::tcp::socket> m_sockets;
+        std::vector<StreamProtocol::endpoint> m_endpoints; // 비어 있으면 start()에서 주소 해석
+        std::vector<StreamProtocol::socket> m_sockets;
     };
 }
@@ -1,29 +1,58 @@
 ﻿#include "Session.h"
 #include "Packet.h"
+#include "Compression.h"
 #include "Event.h"
 
 namespace net  
 {
-    Session::Session(SessionId sessionId, asio::ip::tcp::socket&& socket, SessionEventQueue& eventQueue)
+    namespace
+    {
+        // 모든 세션이 재조립 중인 메시지 크기의 합 (첫 조각이 알린 크기로 예약)
+        std::atomic<size_t> s_globalReassemblyBytes = 0;
+        std::atomic<size_t> s_globalReassemblyLimit = Session::DefaultGlobalReassemblyLimit;
+    }
+
+    Session::Session(SessionId sessionId, SessionTransportPtr&& transport, SessionEventQueue& eventQueue, IoThreadModel threadModel)
         : m_running(false)
         , m_sessionId(sessionId)
-        , m_socket(std::move(socket))
+        , m_transport(std::move(transport))
         , m_eventQueue(eventQueue)
-        , m_strand(asio::make_strand(m_socket.get_executor()))
+        , m_executor((threadModel == IoThreadModel::ContextPerThread)
+            ? m_transport->getExecutor()
+            : Executor(asio::make_strand(m_transport->getExecutor())))
+        , m_lastReceiveTime(std::chrono::steady_clock::now().time_since_epoch().count())
+        , m_sendGraceTimer(m_executor)
     {
         spdlog::debug("[Session {}] 세션 생성", m_sessionId);
     }
 
     Session::~Session()
     {
+        resetReassembly();
+        releaseDecompressBlock();
         spdlog::debug("[Session {}] 세션 소멸", m_sessionId);
     }
 
-    SessionPtr Session::createInstance(asio::ip::tcp::socket&& socket, SessionEventQueue& eventQueue)
+    void Session::setGlobalReassemblyLimit(size_t limit)
+    {
+        s_globalReassemblyLimit.store(limit, std::memory_order_relaxed);
+    }
+
+    size_t Session::getGlobalReassemblyBytes()
+    {
+        return s_globalReassemblyBytes.load(std::memory_order_relaxed);
+    }
+
+    SessionPtr Session::createInstance(asio::generic::stream_protocol::socket&& socket, SessionEventQueue& eventQueue, IoThreadModel threadModel)
+    {
+        return createInstance(std::make_unique<SocketTransport>(std::move(socket)), eventQueue, threadModel);
+    }
+
+    SessionPtr Session::createInstance(SessionTransportPtr&& transport, SessionEventQueue& eventQueue, IoThreadModel threadModel)
     {
         static std::atomic<SessionId> s_nextSessionId = 1;
 
-        return std::make_shared<Session>(s_nextSessionId.fetch_add(1), std::move(socket), eventQueue);
+        return std::make_shared<Session>(s_nextSessionId.fetch_add(1), std::move(transport), eventQueue, threadModel);
     }
 
     void Session::start()
@@ -37,7 +66,7 @@ namespace net
         spdlog::debug("[Session {}] 세션 시작", m_sessionId);
 
         asio::post(
-            m_strand,
+            m_executor,
             [this, self = shared_from_this()]()
             {
                 // 비동기 읽기 시작
@@ -56,7 +85,7 @@ namespace net
         spdlog::debug("[Session {}] 세션 중지", m_sessionId);
 
         asio::post(
-            m_strand,
+            m_executor,
             [this, self = shared_from_this()]()
             {
                 close();
@@ -71,7 +100,7 @@ namespace net
         }
 
         asio::post(
-            m_strand,
+            m_executor,
             [this, self = shared_from_this()]()
             {
                 asyncRead();
@@ -86,39 +115,113 @@ namespace net
         }
 
         asio::post(
-            m_strand,
+            m_executor,
             [this, self = shared_from_this(), chunk = chunk]()
             {
-                bool writeInProgress = !m_sendQueue.empty();
-                m_sendQueue.push_back(chunk);
+                enqueueSend(chunk);
+            });
+    }
 
-                // 쓰기 작업이 진행 중이지 않으면 쓰기 요청
-                if (!writeInProgress)
-                {
-                    asyncWrite();
-                }
+    void Session::dispatchSend(const SendBufferChunkPtr& chunk)
+    {
+        if (!m_running.load())
+        {
+            return;
+        }
+
+        asio::dispatch(
+            m_executor,
+            [this, self = shared_from_this(), chunk = chunk]()
+            {
+                enqueueSend(chunk);
             });
     }
 
-    bool Session::getFrontPacket(PacketView& view) const  
+    static_assert(MaxPacketSize <= ReceiveBuffer::DefaultSize, "a packet must fit in a single read request");
+
+    bool Session::getFrontPacket(PacketView& view)  
     {
-        if (m_receiveBuffer.getUnreadSize() < sizeof(PacketHeader))  
-        {  
-            return false;
+        if (m_frontPacketReady)
+        {
+            // 재조립 또는 압축 해제를 마친 패킷을 아직 꺼내가지 않음
+            view = m_frontPacket;
+            return true;
         }
 
-        const PacketHeader* header = reinterpret_cast<const PacketHeader*>(m_receiveBuffer.getReadPtr());
-        if (m_receiveBuffer.getUnreadSize() < header->size)
-        {  
+        PacketView packet;
+        if (!readFrontPacket(packet))
+        {
             return false;
         }
 
-        view.header = header;
-        view.payload = m_receiveBuffer.getReadPtr() + sizeof(PacketHeader);
+        if ((packet.id == CompressedPacketId) && !decompressPacket(packet))
+        {
+            stop();
+            return false;
+        }
 
+        m_frontPacket = packet;
+        m_frontPacketReady = true;
+        view = packet;
         return true;
     }
 
+    bool Session::readFrontPacket(PacketView& view)
+    {
+        if (m_reassemblyCompleted)
+        {
+            // 재조립을 마친 메시지를 아직 꺼내가지 않음
+            view = PacketView(m_reassemblyId, m_reassemblyBuffer.data(), m_reassemblySize);
+            return true;
+        }
+
+        while (m_running.load())
+        {
+            if (m_receiveBuffer.getUnreadSize() < sizeof(PacketHeader))  
+            {  
+                return false;
+            }
+
+            const PacketHeader* header = reinterpret_cast<const PacketHeader*>(m_receiveBuffer.getReadPtr());
+            if ((header->size < sizeof(PacketHeader)) || (MaxPacketSize < header->size))
+            {
+                spdlog::error("[Session {}] 잘못된 패킷 크기: {}", m_sessionId, header->size);
+                stop();
+                return false;
+            }
+
+            if (m_receiveBuffer.getUnreadSize() < header->size)
+            {  
+                return false;
+            }
+
+            if ((header->id != FragmentBeginPacketId) && (header->id != FragmentPacketId))
+            {
+                view = PacketView(m_receiveBuffer.getReadPtr());
+                return true;
+            }
+
+            if (!appendFragment(*header))
+            {
+                stop();
+                return false;
+            }
+
+            if (m_reassemblyBuffer.size() == m_reassemblySize)
+            {
+                // 마지막 조각은 popFrontPacket()에서 수신 버퍼와 함께 제거
+                m_reassemblyCompleted = true;
+                view = PacketView(m_reassemblyId, m_reassemblyBuffer.data(), m_reassemblySize);
+                return true;
+            }
+
+            // 중간 조각은 재조립 버퍼로 복사했으므로 바로 제거
+            m_receiveBuffer.onRead(header->size);
+        }
+
+        return false;
+    }
+
     void Session::popFrontPacket()
     {
         if (m_running.load() == false)  
@@ -133,6 +236,321 @@ namespace net
 
         // 패킷 크기만큼 읽기 오프셋 이동
         m_receiveBuffer.onRead(header->size);
+
+        if (m_reassemblyCompleted)
+        {
+            resetReassembly();
+        }
+
+        releaseDecompressBlock();
+        m_frontPacketReady = false;
+    }
+
+    bool Session::decompressPacket(PacketView& packet)
+    {
+        if (packet.payloadSize < sizeof(CompressionHeader))
+        {
+            spdlog::error("[Session {}] 잘못된 압축 패킷 크기: {}", m_sessionId, packet.payloadSize);
+            return false;
+        }
+
+        const CompressionHeader* header = reinterpret_cast<const CompressionHeader*>(packet.payload);
+        if ((header->originalSize == 0) || (m_reassemblyLimit < header->originalSize))
+        {
+            spdlog::error("[Session {}] 잘못된 압축 해제 크기: {} (한도: {})", m_sessionId, header->originalSize, m_reassemblyLimit);
+            return false;
+        }
+
+        if ((header->id == CompressedPacketId) || (header->id == FragmentBeginPacketId) || (header->id == FragmentPacketId))
+        {
+            spdlog::error("[Session {}] 압축 패킷 안의 잘못된 패킷 ID: {}", m_sessionId, header->id);
+            return false;
+        }
+
+        // 작은 압축 패킷 하나로 큰 버퍼를 확보할 수 있으므로 조각 메시지와 같은 전체 한도에서 예약
+        if (!reserveGlobalReassembly(header->originalSize))
+        {
+            spdlog::warn("[Session {}] 전체 재조립 한도 초과: 압축 해제 {} bytes 요청, {} bytes 재조립 중", m_sessionId, header->originalSize, getGlobalReassemblyBytes());
+            return false;
+        }
+
+        // 메시지 큐에서 파싱이 끝나면 popFrontPacket()에서 풀로 반환
+        assert(m_decompressBlock == nullptr);
+        m_decompressBlock = SendBufferPool::getLocal().acquire(header->originalSize);
+        m_decompressSize = header->originalSize;
+
+        const uint8_t* compressed = packet.payload + sizeof(CompressionHeader);
+        const size_t compressedSize = packet.payloadSize - sizeof(CompressionHeader);
+
+        if (!PacketCompressor::decompress(header->codec, compressed, compressedSize, m_decompressBlock->getData(), header->originalSize))
+        {
+            spdlog::error("[Session {}] 압축 해제 실패 (코덱: {})", m_sessionId, static_cast<int>(header->codec));
+            releaseDecompressBlock();
+            return false;
+        }
+
+        packet = PacketView(header->id, m_decompressBlock->getData(), header->originalSize);
+        return true;
+    }
+
+    void Session::releaseDecompressBlock()
+    {
+        if (m_decompressBlock != nullptr)
+        {
+            SendBufferPool::release(m_decompressBlock);
+            m_decompressBlock = nullptr;
+
+            s_globalReassemblyBytes.fetch_sub(m_decompressSize, std::memory_order_relaxed);
+            m_decompressSize = 0;
+        }
+    }
+
+    bool Session::appendFragment(const PacketHeader& header)
+    {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&header + 1);
+        size_t dataSize = header.size - sizeof(PacketHeader);
+
+        if (header.id == FragmentBeginPacketId)
+        {
+            if ((m_reassemblySize != 0) || (dataSize < sizeof(FragmentHeader)))
+            {
+                spdlog::error("[Session {}] 잘못된 첫 조각 패킷", m_sessionId);
+                return false;
+            }
+
+            const FragmentHeader* fragmentHeader = reinterpret_cast<const FragmentHeader*>(data);
+            const size_t messageSize = fragmentHeader->messageSize;
+            if ((messageSize == 0) || (m_reassemblyLimit < messageSize))
+            {
+                spdlog::error("[Session {}] 잘못된 조각 메시지 크기: {} (한도: {})", m_sessionId, messageSize, m_reassemblyLimit);
+                return false;
+            }
+
+            if (!reserveGlobalReassembly(messageSize))
+            {
+                spdlog::warn("[Session {}] 전체 재조립 한도 초과: {} bytes 요청, {} bytes 재조립 중", m_sessionId, messageSize, getGlobalReassemblyBytes());
+                return false;
+            }
+
+            m_reassemblySize = messageSize;
+            m_reassemblyId = fragmentHeader->id;
+
+            // 상대가 알린 크기를 그대로 확보하지 않고 조각이 실제로 도착하는 만큼 버퍼를 늘린다
+            m_reassemblyBuffer.clear();
+            m_reassemblyBuffer.reserve(std::min(messageSize, MaxReassemblyReserveSize));
+
+            data += sizeof(FragmentHeader);
+            dataSize -= sizeof(FragmentHeader);
+        }
+        else if (m_reassemblySize == 0)
+        {
+            spdlog::error("[Session {}] 첫 조각 없이 이어지는 조각 수신", m_sessionId);
+            return false;
+        }
+
+        if (m_reassemblySize - m_reassemblyBuffer.size() < dataSize)
+        {
+            spdlog::error("[Session {}] 조각 데이터가 메시지 크기를 넘음", m_sessionId);
+            return false;
+        }
+
+        m_reassemblyBuffer.insert(m_reassemblyBuffer.end(), data, data + dataSize);
+
+        return true;
+    }
+
+    void Session::resetReassembly()
+    {
+        if (m_reassemblySize != 0)
+        {
+            s_globalReassemblyBytes.fetch_sub(m_reassemblySize, std::memory_order_relaxed);
+        }
+
+        m_reassemblySize = 0;
+        m_reassemblyId = 0;
+        m_reassemblyCompleted = false;
+
+        // 미리 확보하는 크기 이하의 버퍼는 다음 조각 메시지에 재사용하고, 더 커진 버퍼만 메모리를 돌려준다
+        m_reassemblyBuffer.clear();
+        if (MaxReassemblyReserveSize < m_reassemblyBuffer.capacity())
+        {
+            std::vector<uint8_t>().swap(m_reassemblyBuffer);
+        }
+    }
+
+    bool Session::reserveGlobalReassembly(size_t size)
+    {
+        const size_t limit = s_globalReassemblyLimit.load(std::memory_order_relaxed);
+        size_t current = s_globalReassemblyBytes.load(std::memory_order_relaxed);
+        do
+        {
+            if ((limit < current) || (limit - current < size))
+            {
+                return false;
+            }
+        } while (!s_globalReassemblyBytes.compare_exchange_weak(current, current + size, std::memory_order_relaxed));
+
+        return true;
+    }
+
+    void Session::enqueueSend(const SendBufferChunkPtr& chunk)
+    {
+        // 중지한 뒤에 실행기에 남아 있던 송신은 버린다 (hard limit으로 끊긴 세션의 큐가 계속 늘어나지 않도록)
+        if (!m_running.load())
+        {
+            return;
+        }
+
+        if (m_overHighWatermark &&
+            (m_sendQueueConfig.policy == SendQueuePolicy::Coalesce) &&
+            coalesceSend(chunk))
+        {
+            return;
+        }
+
+        bool writeInProgress = !m_sendQueue.empty();
+        m_sendQueue.push_back(chunk);
+        m_sendQueueBytes += chunk->getWrittenSize();
+
+        // 쓰기 작업이 진행 중이지 않으면 쓰기 요청
+        if (!writeInProgress)
+        {
+            asyncWrite();
+        }
+
+        if (m_sendQueueConfig.highWatermark < m_sendQueueBytes)
+        {
+            onSendQueueHigh();
+        }
+
+        updateSendQueueMetrics();
+    }
+
+    bool Session::coalesceSend(const SendBufferChunkPtr& chunk)
+    {
+        const uint64_t coalesceKey = chunk->getCoalesceKey();
+        if (coalesceKey == 0)
+        {
+            return false;
+        }
+
+        // 전송 중인 청크는 건드리지 않고, 가장 최근에 대기한 같은 키의 청크를 교체
+        for (size_t i = m_sendQueue.size(); m_writingCount < i; --i)
+        {
+            SendBufferChunkPtr& queued = m_sendQueue[i - 1];
+            if (queued->getCoalesceKey() == coalesceKey)
+            {
+                m_sendQueueBytes -= queued->getWrittenSize();
+                m_sendQueueBytes += chunk->getWrittenSize();
+                queued = chunk;
+
+                m_coalescedChunkCount.fetch_add(1, std::memory_order_relaxed);
+                updateSendQueueMetrics();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Session::dropOldestSends()
+    {
+        auto it = m_sendQueue.begin() + m_writingCount;
+        while ((it != m_sendQueue.end()) &&
+               (m_sendQueueConfig.lowWatermark < m_sendQueueBytes))
+        {
+            if ((*it)->isDroppable())
+            {
+                m_sendQueueBytes -= (*it)->getWrittenSize();
+                it = m_sendQueue.erase(it);
+                m_droppedChunkCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void Session::onSendQueueHigh()
+    {
+        switch (m_sendQueueConfig.policy)
+        {
+        case SendQueuePolicy::DropOldest:
+            dropOldestSends();
+            break;
+        case SendQueuePolicy::PauseProducers:
+            m_sendPaused.store(true, std::memory_order_relaxed);
+            break;
+        case SendQueuePolicy::Coalesce:
+        case SendQueuePolicy::Disconnect:
+            break;
+        }
+
+        if (m_sendQueueBytes <= m_sendQueueConfig.highWatermark)
+        {
+            return;
+        }
+
+        if (m_sendQueueConfig.hardLimit < m_sendQueueBytes)
+        {
+            spdlog::warn("[Session {}] 송신 큐 한도 초과: {} bytes", m_sessionId, m_sendQueueBytes);
+            stop();
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (!m_overHighWatermark)
+        {
+            m_overHighWatermark = true;
+            m_overHighWatermarkSince = now;
+
+            // 클라이언트가 읽지 않고 더 보낼 것도 없으면 다음 송신이 오지 않으므로 타이머로 유예 시간을 확인
+            m_sendGraceTimer.expires_at(now + m_sendQueueConfig.disconnectGracePeriod);
+            m_sendGraceTimer.async_wait(
+                [this, self = shared_from_this()](const asio::error_code& error)
+                {
+                    onSendGraceExpired(error);
+                });
+        }
+        else if (m_sendQueueConfig.disconnectGracePeriod <= (now - m_overHighWatermarkSince))
+        {
+            spdlog::warn("[Session {}] 느린 소비자 연결 종료: {} bytes 대기", m_sessionId, m_sendQueueBytes);
+            stop();
+        }
+    }
+
+    void Session::onSendGraceExpired(const asio::error_code& error)
+    {
+        if (error || !m_overHighWatermark || !m_running.load())
+        {
+            // 취소됐거나 유예 시간 안에 큐가 low watermark 아래로 내려감
+            return;
+        }
+
+        spdlog::warn("[Session {}] 느린 소비자 연결 종료: {} bytes 대기", m_sessionId, m_sendQueueBytes);
+        stop();
+    }
+
+    void Session::onSendQueueDrained()
+    {
+        if (m_overHighWatermark)
+        {
+            m_sendGraceTimer.cancel();
+        }
+
+        m_overHighWatermark = false;
+        m_sendPaused.store(false, std::memory_order_relaxed);
+    }
+
+    void Session::updateSendQueueMetrics()
+    {
+        m_queuedBytes.store(m_sendQueueBytes, std::memory_order_relaxed);
+        m_queuedChunkCount.store(m_sendQueue.size(), std::memory_order_relaxed);
+        if (m_peakQueuedBytes.load(std::memory_order_relaxed) < m_sendQueueBytes)
+        {
+            m_peakQueuedBytes.store(m_sendQueueBytes, std::memory_order_relaxed);
+        }
     }
 
     void Session::asyncRead()  
@@ -142,17 +560,11 @@ namespace net
             return;  
         }
 
-        m_socket.async_read_some(
+        m_transport->asyncReadSome(
+            shared_from_this(),
             asio::buffer(
                 m_receiveBuffer.getWritePtr(),
-                m_receiveBuffer.getUnwrittenSize()),
-            asio::bind_executor(
-                m_strand,
-                [this, self = shared_from_this()]
-                (const asio::error_code& error, size_t bytesRead)
-                {
-                    onRead(error, bytesRead);
-                }));
+                m_receiveBuffer.getReadRequestSize()));
     }
 
     void Session::onRead(const asio::error_code& error, size_t bytesRead)
@@ -164,6 +576,7 @@ namespace net
         }
 
         m_receiveBuffer.onWritten(bytesRead);
+        m_lastReceiveTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
 
         // 이벤트 큐에 receive 이벤트 추가
         SessionEventPtr event = std::make_shared<SessionReceiveEvent>(m_sessionId);
@@ -177,18 +590,28 @@ namespace net
             return;  
         }
 
-        asio::async_write(
-            m_socket,
-            asio::buffer(
-                m_sendQueue.front()->getReadPtr(),
-                m_sendQueue.front()->getWrittenSize()),
-            asio::bind_executor(
-                m_strand,
-                [this, self = shared_from_this()]
-                (const asio::error_code& error, size_t bytesWritten)
+        // 큐에 쌓인 청크를 한 번의 쓰기 요청으로 묶는다
+        m_writeBuffers.clear();
+        m_writingCount = std::min(m_sendQueue.size(), MaxWriteBatchCount);
+        for (size_t i = 0; i < m_writingCount; ++i)
+        {
+            const SendBufferChunkPtr& chunk = m_sendQueue[i];
+
+            // 같은 SendBuffer 블록에서 연속으로 열린 청크는 하나의 버퍼로 합친다
+            if (!m_writeBuffers.empty())
+            {
+                asio::const_buffer& last = m_writeBuffers.back();
+                if (static_cast<const uint8_t*>(last.data()) + last.size() == chunk->getReadPtr())
                 {
-                    onWritten(error, bytesWritten);
-                }));
+                    last = asio::const_buffer(last.data(), last.size() + chunk->getWrittenSize());
+                    continue;
+                }
+            }
+
+            m_writeBuffers.emplace_back(chunk->getReadPtr(), chunk->getWrittenSize());
+        }
+
+        m_transport->asyncWrite(shared_from_this(), m_writeBuffers);
     }
 
     void Session::onWritten(const asio::error_code& error, size_t bytesWritten)
@@ -199,7 +622,24 @@ namespace net
             return;  
         }
         
-        m_sendQueue.pop_front();
+        assert(m_writingCount <= m_sendQueue.size());
+
+        for (size_t i = 0; i < m_writingCount; ++i)
+        {
+            m_sendQueueBytes -= m_sendQueue[i]->getWrittenSize();
+        }
+
+        m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_writingCount);
+        m_sentChunkCount.fetch_add(m_writingCount, std::memory_order_relaxed);
+        m_writingCount = 0;
+
+        if (m_sendQueueBytes <= m_sendQueueConfig.lowWatermark)
+        {
+            onSendQueueDrained();
+        }
+
+        updateSendQueueMetrics();
+
         if (!m_sendQueue.empty())
         {
             // 큐에 남아있는 데이터가 있다면 다음 쓰기 요청
@@ -251,36 +691,73 @@ namespace net
     void Session::close()  
     {
         assert(!m_running.load());
-        assert(m_socket.is_open());
+        assert(m_transport->isOpen());
 
         spdlog::debug("[Session {}] 세션 닫기", m_sessionId);
 
-        asio::error_code error;
+        // 진행 중인 비동기 작업을 취소하고 연결 닫기
+        m_sendGraceTimer.cancel();
 
-        // 모든 비동기 작업을 취소
-        m_socket.cancel(error);
+        asio::error_code error;
+        m_transport->close(error);
         if (error)
         {
             handleError(error);
         }
 
-        // 송수신 기능 중지
-        m_socket.shutdown(asio::ip::tcp::socket::shutdown_both, error);
-        if (error)
+        // 이벤트 큐에 close 이벤트 추가
+        SessionEventPtr event = std::make_shared<SessionCloseEvent>(m_sessionId);
+        m_eventQueue.push(std::move(event));
+    }
+
+    void SessionFanout::add(const SessionPtr& session)
+    {
+        assert(session);
+
+        Session::Executor executor = session->getExecutor();
+        auto it = std::find_if(
+            m_groups.begin(), m_groups.end(),
+            [&executor](const ExecutorGroup& group)
+            {
+                return group.executor == executor;
+            });
+
+        if (it == m_groups.end())
         {
-            handleError(error);
+            m_groups.push_back(ExecutorGroup{ executor, {} });
+            it = std::prev(m_groups.end());
         }
 
-        // 소켓 닫기
-        m_socket.close(error);
-        if (error)
+        it->sessions.push_back(session);
+        ++m_recipientCount;
+    }
+
+    void SessionFanout::send(const SendBufferChunkPtr& chunk)
+    {
+        for (auto& group : m_groups)
         {
-            handleError(error);
+            auto& sessions = group.sessions;
+            for (size_t begin = 0; begin < sessions.size(); begin += MaxBatchSize)
+            {
+                // 같은 실행기를 여러 스레드가 돌리는 경우를 위해 배치 크기로 나눠 병렬 처리 여지를 남긴다
+                const size_t end = std::min(begin + MaxBatchSize, sessions.size());
+                std::vector<SessionPtr> batch(
+                    std::make_move_iterator(sessions.begin() + begin),
+                    std::make_move_iterator(sessions.begin() + end));
+
+                asio::post(
+                    group.executor,
+                    [batch = std::move(batch), chunk = chunk]()
+                    {
+                        for (const auto& session : batch)
+                        {
+                            session->dispatchSend(chunk);
+                        }
+                    });
+            }
         }
 
-        // 이벤트 큐에 close 이벤트 추가
-        SessionEventPtr event = std::make_shared<SessionCloseEvent>(m_sessionId);
-        m_eventQueue.push(std::move(event));
+        m_groups.clear();
     }
 
     bool SessionManager::send(SessionId sessionId, const SendBufferChunkPtr& chunk)
@@ -296,24 +773,28 @@ namespace net
         return true;
     }
 
-    void SessionManager::broadcast(const SendBufferChunkPtr& chunk)
+    size_t SessionManager::broadcast(const SendBufferChunkPtr& chunk)
     {
+        SessionFanout fanout;
         for (const auto& pair : m_sessions)
         {
-            pair.second->send(chunk);
-        }
-    }
+            if (!pair.second->isRunning())
+            {
+                continue;
+            }
 
-    void SessionManager::broadcast(const std::vector<SessionId>& sessionIds, const SendBufferChunkPtr& chunk)
-    {
-        for (SessionId sessionId : sessionIds)
-        {
-            auto session = findSession(sessionId);
-            if (session && session->isRunning())
+            if (chunk->isDroppable() && pair.second->isSendPaused())
             {
-                session->send(chunk);
+                // 송신 큐가 줄어들 때까지 생략해도 되는 데이터는 보내지 않는다
+                continue;
             }
+
+            fanout.add(pair.second);
         }
+
+        fanout.send(chunk);
+
+        return fanout.getRecipientCount();
     }
 
     void SessionManager::stopAllSessions()
@@ -5,6 +5,9 @@
 #include <memory>
 #include "Core/LockQueue.h"
 #include "Buffer.h"
+#include "Packet.h"
+#include "Thread.h"
+#include "Transport.h"
 
 namespace net
 {
@@ -14,14 +17,55 @@ namespace net
 
     struct PacketView;
 
+    // 송신 큐가 high watermark를 넘었을 때의 처리 정책
+    enum class SendQueuePolicy
+    {
+        DropOldest,     // 전송 중이 아닌 가장 오래된 droppable 청크부터 low watermark까지 버림
+        Coalesce,       // 같은 병합 키를 가진 대기 청크를 새 청크로 교체
+        PauseProducers, // 큐가 low watermark 아래로 내려갈 때까지 isSendPaused()로 생산자에게 알림 (브로드캐스트는 droppable 청크를 건너뜀)
+        Disconnect,     // 별도 처리 없이 유예 시간 경과 후 연결 종료
+    };
+
+    struct SendQueueConfig
+    {
+        size_t highWatermark = 1024 * 1024;
+        size_t lowWatermark = 256 * 1024;
+        size_t hardLimit = 4 * 1024 * 1024;     // 넘으면 유예 없이 연결 종료
+        SendQueuePolicy policy = SendQueuePolicy::DropOldest;
+
+        // 정책을 적용한 뒤에도 high watermark 위에 머무를 수 있는 시간 (모든 정책 공통, 이후 송신이 없어도 타이머로 종료)
+        std::chrono::milliseconds disconnectGracePeriod = std::chrono::seconds(5);
+    };
+
     class Session
         : public std::enable_shared_from_this<Session>
     {
     public:
-        Session(SessionId sessionId, asio::ip::tcp::socket&& socket, SessionEventQueue& eventQueue);
+        using Executor = asio::any_io_executor;
+
+        // 한 번의 쓰기 요청(writev / io_uring 제출)에 묶는 최대 청크 수
+        static constexpr size_t MaxWriteBatchCount = 64;
+
+        // 첫 조각에서 미리 확보하는 재조립 버퍼 크기의 상한 (나머지는 조각이 도착하는 만큼 늘리고, 넘게 커진 버퍼는 재조립 후 반환)
+        static constexpr size_t MaxReassemblyReserveSize = 4 * MaxPacketSize;
+
+        // 모든 세션이 동시에 재조립할 수 있는 메시지 크기 합계의 기본 한도
+        static constexpr size_t DefaultGlobalReassemblyLimit = 256 * 1024 * 1024;
+
+    public:
+        Session(SessionId sessionId, SessionTransportPtr&& transport, SessionEventQueue& eventQueue, IoThreadModel threadModel);
         ~Session();
 
-        static SessionPtr createInstance(asio::ip::tcp::socket&& socket, SessionEventQueue& eventQueue);
+        // TCP 소켓과 유닉스 도메인 소켓 모두 generic 소켓으로 이동해 받는다
+        static SessionPtr createInstance(
+            asio::generic::stream_protocol::socket&& socket,
+            SessionEventQueue& eventQueue,
+            IoThreadModel threadModel = IoThreadModel::SharedContext);
+
+        static SessionPtr createInstance(
+            SessionTransportPtr&& transport,
+            SessionEventQueue& eventQueue,
+            IoThreadModel threadModel = IoThreadModel::SharedContext);
 
         void start();
         void stop();
@@ -29,14 +73,56 @@ namespace net
         void receive();
         void send(const SendBufferChunkPtr& chunk);
 
-        bool getFrontPacket(PacketView& view) const;
+        // 세션의 IO 스레드에서 호출하면 실행기가 비어 있을 때 post 없이 바로 송신 큐에 추가
+        void dispatchSend(const SendBufferChunkPtr& chunk);
+
+        // 조각 패킷은 마지막 조각까지 받은 뒤 재조립한 메시지 하나로, 압축 패킷은 압축을 푼 메시지로 반환 (메인 스레드에서만 호출)
+        bool getFrontPacket(PacketView& view);
         void popFrontPacket();
 
         bool isRunning() const { return m_running.load(); }
         SessionId getSessionId() const { return m_sessionId; }
         ReceiveBuffer& getReceiveBuffer() { return m_receiveBuffer; }
+        Executor getExecutor() { return m_transport->getExecutor(); }
+
+        // 마지막으로 데이터를 수신한 시간 (다른 스레드에서 읽을 수 있음, 수신 전에는 생성 시간)
+        std::chrono::steady_clock::time_point getLastReceiveTime() const
+        {
+            return std::chrono::steady_clock::time_point(
+                std::chrono::steady_clock::duration(m_lastReceiveTime.load(std::memory_order_relaxed)));
+        }
+
+        // start() 전에 설정
+        void setSendQueueConfig(const SendQueueConfig& config) { m_sendQueueConfig = config; }
+
+        // 세션 하나가 재조립하거나 압축을 풀 수 있는 메시지 크기 (start() 전에 설정, 넘으면 연결 종료)
+        void setReassemblyLimit(size_t limit) { m_reassemblyLimit = std::min(limit, MaxMessageSize); }
+
+        // 모든 세션의 재조립 한도 (첫 조각이 알린 크기나 압축을 풀 크기만큼 예약하고 메시지를 꺼내면 반환, 예약하지 못한 세션은 연결 종료)
+        static void setGlobalReassemblyLimit(size_t limit);
+        static size_t getGlobalReassemblyBytes();
+
+        // 송신 큐 지표 (다른 스레드에서 읽을 수 있음)
+        size_t getQueuedBytes() const { return m_queuedBytes.load(std::memory_order_relaxed); }
+        size_t getQueuedChunkCount() const { return m_queuedChunkCount.load(std::memory_order_relaxed); }
+        size_t getPeakQueuedBytes() const { return m_peakQueuedBytes.load(std::memory_order_relaxed); }
+        uint64_t getSentChunkCount() const { return m_sentChunkCount.load(std::memory_order_relaxed); }
+        uint64_t getDroppedChunkCount() const { return m_droppedChunkCount.load(std::memory_order_relaxed); }
+        uint64_t getCoalescedChunkCount() const { return m_coalescedChunkCount.load(std::memory_order_relaxed); }
+        bool isSendPaused() const { return m_sendPaused.load(std::memory_order_relaxed); }
 
     private:
+        // 전송 계층은 완료 핸들러를 호출하기 위해 실행기와 onRead/onWritten에 접근
+        friend class SessionTransport;
+
+        void enqueueSend(const SendBufferChunkPtr& chunk);
+        bool coalesceSend(const SendBufferChunkPtr& chunk);
+        void dropOldestSends();
+        void onSendQueueHigh();
+        void onSendGraceExpired(const asio::error_code& error);
+        void onSendQueueDrained();
+        void updateSendQueueMetrics();
+
         void asyncRead();
         void onRead(const asio::error_code& error, size_t bytesRead);
         void asyncWrite();
@@ -45,22 +131,120 @@ namespace net
         void handleError(const asio::error_code& error);
         void close();
 
+        bool readFrontPacket(PacketView& view);
+        bool appendFragment(const PacketHeader& header);
+        void resetReassembly();
+        static bool reserveGlobalReassembly(size_t size);
+        bool decompressPacket(PacketView& packet);
+        void releaseDecompressBlock();
+
     private:
         std::atomic<bool> m_running;
         SessionId m_sessionId;
-        asio::ip::tcp::socket m_socket;
+        SessionTransportPtr m_transport;
         SessionEventQueue& m_eventQueue;
-        asio::strand<asio::ip::tcp::socket::executor_type> m_strand;
+        Executor m_executor; // 세션 핸들러를 직렬화하는 실행기 (공유 io_context면 strand, 전용 io_context면 소켓 실행기)
         std::deque<SendBufferChunkPtr> m_sendQueue;
+        std::vector<asio::const_buffer> m_writeBuffers;
+        size_t m_writingCount = 0; // 진행 중인 쓰기 요청에 포함된 청크 수
         ReceiveBuffer m_receiveBuffer;
+        std::atomic<std::chrono::steady_clock::rep> m_lastReceiveTime;
+
+        // 조각 패킷 재조립 (메인 스레드에서만 사용)
+        // 상대가 알린 전체 크기는 전역 한도에서 예약만 하고, 버퍼는 조각이 도착하는 만큼 늘려 조각마다 한 번씩만 복사된다
+        std::vector<uint8_t> m_reassemblyBuffer;
+        size_t m_reassemblyLimit = MaxMessageSize;
+        size_t m_reassemblySize = 0;            // 재조립할 메시지 전체 크기 (0이면 재조립 중이 아님)
+        PacketId m_reassemblyId = 0;
+        bool m_reassemblyCompleted = false;     // 마지막 조각이 아직 수신 버퍼 앞에 남아 있음
+
+        // getFrontPacket()이 반환한 패킷 (popFrontPacket()까지 유지, 메인 스레드에서만 사용)
+        PacketView m_frontPacket;
+        bool m_frontPacketReady = false;
+        SendBufferBlock* m_decompressBlock = nullptr;  // 압축을 푼 메시지를 담는 풀 블록
+        size_t m_decompressSize = 0;                    // 압축을 푼 크기 (블록을 반환할 때 전체 재조립 예약에서 뺀다)
+
+        // 송신 큐 backpressure (실행기 안에서만 기록)
+        SendQueueConfig m_sendQueueConfig;
+        size_t m_sendQueueBytes = 0;
+        bool m_overHighWatermark = false;
+        std::chrono::steady_clock::time_point m_overHighWatermarkSince;
+        asio::steady_timer m_sendGraceTimer;    // high watermark를 넘은 뒤 유예 시간이 지나면 연결 종료
+        std::atomic<size_t> m_queuedBytes = 0;
+        std::atomic<size_t> m_queuedChunkCount = 0;
+        std::atomic<size_t> m_peakQueuedBytes = 0;
+        std::atomic<uint64_t> m_sentChunkCount = 0;
+        std::atomic<uint64_t> m_droppedChunkCount = 0;
+        std::atomic<uint64_t> m_coalescedChunkCount = 0;
+        std::atomic<bool> m_sendPaused = false;
+    };
+
+    // 하나의 청크를 여러 세션에 보낼 때 수신자를 IO 실행기별로 묶어 배치 단위로 한 번씩만 post
+    // 각 배치는 IO 스레드에서 세션들의 송신 큐에 청크를 추가한다
+    class SessionFanout
+    {
+    public:
+        static constexpr size_t MaxBatchSize = 256;
+
+    public:
+        void add(const SessionPtr& session);
+        void send(const SendBufferChunkPtr& chunk);
+
+        size_t getRecipientCount() const { return m_recipientCount; }
+
+    private:
+        struct ExecutorGroup
+        {
+            Session::Executor executor;
+            std::vector<SessionPtr> sessions;
+        };
+
+        std::vector<ExecutorGroup> m_groups;
+        size_t m_recipientCount = 0;
     };
 
     class SessionManager
     {
     public:
         bool send(SessionId sessionId, const SendBufferChunkPtr& chunk);
-        void broadcast(const SendBufferChunkPtr& chunk);
-        void broadcast(const std::vector<SessionId>& sessionIds, const SendBufferChunkPtr& chunk);
+
+        // 전송 대상 세션 수 반환
+        size_t broadcast(const SendBufferChunkPtr& chunk);
+
+        // 송신이 멈춘 세션(SendQueuePolicy::PauseProducers)에는 droppable 청크를 보내지 않고 pausedCount에 센다
+        template<typename TSessionIds>
+        size_t broadcast(const TSessionIds& sessionIds, const SendBufferChunkPtr& chunk, size_t& pausedCount)
+        {
+            SessionFanout fanout;
+            pausedCount = 0;
+            for (SessionId sessionId : sessionIds)
+            {
+                auto it = m_sessions.find(sessionId);
+                if ((it == m_sessions.end()) || !it->second->isRunning())
+                {
+                    continue;
+                }
+
+                if (chunk->isDroppable() && it->second->isSendPaused())
+                {
+                    ++pausedCount;
+                    continue;
+                }
+
+                fanout.add(it->second);
+            }
+
+            fanout.send(chunk);
+
+            return fanout.getRecipientCount();
+        }
+
+        template<typename TSessionIds>
+        size_t broadcast(const TSessionIds& sessionIds, const SendBufferChunkPtr& chunk)
+        {
+            size_t pausedCount = 0;
+            return broadcast(sessionIds, chunk, pausedCount);
+        }
 
         void stopAllSessions();
 
@@ -1,33 +1,72 @@
 ﻿#include "Thread.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#endif // __linux__
+
 namespace net
 {
-    IoThreadPool::IoThreadPool()
-        : m_context()
-        , m_workGuard(asio::make_work_guard(m_context))
-    {}
+    IoThreadPool::IoThreadPool(size_t threadCount, IoThreadModel threadModel, SessionAssignment sessionAssignment)
+        : m_threadCount(std::max<size_t>(threadCount, 1))
+        , m_threadModel(threadModel)
+        , m_sessionAssignment(sessionAssignment)
+    {
+        const size_t contextCount = (m_threadModel == IoThreadModel::ContextPerThread) ? m_threadCount : 1;
+
+        m_contexts.reserve(contextCount);
+        m_workGuards.reserve(contextCount);
+        for (size_t i = 0; i < contextCount; ++i)
+        {
+            // 스레드 하나가 전담하는 io_context는 내부 잠금이 필요 없음을 힌트로 전달
+            const int concurrencyHint = (m_threadModel == IoThreadModel::ContextPerThread)
+                ? 1
+                : static_cast<int>(m_threadCount);
+
+            m_contexts.push_back(std::make_unique<asio::io_context>(concurrencyHint));
+            m_workGuards.push_back(asio::make_work_guard(*m_contexts.back()));
+        }
+
+        m_sessionCounts = std::make_unique<std::atomic<size_t>[]>(contextCount);
+        for (size_t i = 0; i < contextCount; ++i)
+        {
+            m_sessionCounts[i].store(0);
+        }
+    }
 
-    void IoThreadPool::run(size_t threadCount)
+    void IoThreadPool::run()
     {
-        for (size_t i = 0; i < threadCount; ++i)
+        for (size_t i = 0; i < m_threadCount; ++i)
         {
+            asio::io_context& context = *m_contexts[i % m_contexts.size()];
             m_threads.emplace_back(
-                [this]()
+                [&context]()
                 {
-                    m_context.run();
+                    context.run();
                 });
+
+            if (m_threadModel == IoThreadModel::ContextPerThread)
+            {
+                // 세션의 완료 핸들러가 코어를 옮겨 다니지 않도록 스레드를 코어에 고정
+                pinThread(m_threads.back(), i);
+            }
         }
     }
 
     void IoThreadPool::reset()
     {
         // io_context 큐가 비워지면 스레드가 종료되도록 설정
-        m_workGuard.reset();
+        for (auto& workGuard : m_workGuards)
+        {
+            workGuard.reset();
+        }
     }
 
     void IoThreadPool::stop()
     {
-        m_context.stop();
+        for (auto& context : m_contexts)
+        {
+            context->stop();
+        }
     }
 
     void IoThreadPool::join()
@@ -41,4 +80,97 @@ namespace net
         }
         m_threads.clear();
     }
+
+    asio::io_context& IoThreadPool::acquireSessionContext()
+    {
+        size_t index = 0;
+        if (m_contexts.size() > 1)
+        {
+            if (m_sessionAssignment == SessionAssignment::RoundRobin)
+            {
+                index = m_nextContextIndex.fetch_add(1, std::memory_order_relaxed) % m_contexts.size();
+            }
+            else
+            {
+                // 배정된 세션 수가 가장 적은 io_context 선택
+                size_t minCount = m_sessionCounts[0].load(std::memory_order_relaxed);
+                for (size_t i = 1; i < m_contexts.size(); ++i)
+                {
+                    const size_t count = m_sessionCounts[i].load(std::memory_order_relaxed);
+                    if (count < minCount)
+                    {
+                        minCount = count;
+                        index = i;
+                    }
+                }
+            }
+        }
+
+        m_sessionCounts[index].fetch_add(1, std::memory_order_relaxed);
+
+        return *m_contexts[index];
+    }
+
+    void IoThreadPool::retainSessionContext(const asio::execution_context& context)
+    {
+        const size_t index = findContextIndex(context);
+        m_sessionCounts[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void IoThreadPool::releaseSessionContext(const asio::execution_context& context)
+    {
+        const size_t index = findContextIndex(context);
+        assert(m_sessionCounts[index].load() > 0);
+        m_sessionCounts[index].fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    size_t IoThreadPool::findContextIndex(const asio::execution_context& context) const
+    {
+        for (size_t i = 0; i < m_contexts.size(); ++i)
+        {
+            if (m_contexts[i].get() == &context)
+            {
+                return i;
+            }
+        }
+
+        assert(false);
+        return 0;
+    }
+
+    void IoThreadPool::pinThread(std::thread& thread, size_t cpuIndex)
+    {
+#if defined(_WIN32)
+        // 64개가 넘는 논리 프로세서는 프로세서 그룹으로 나뉘고, 선호도 마스크는 그룹 안에서만 유효하다
+        const DWORD cpuCount = std::max<DWORD>(::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS), 1);
+        DWORD groupCpuIndex = static_cast<DWORD>(cpuIndex % cpuCount);
+
+        const WORD groupCount = ::GetActiveProcessorGroupCount();
+        for (WORD group = 0; group < groupCount; ++group)
+        {
+            const DWORD groupCpuCount = ::GetActiveProcessorCount(group);
+            if (groupCpuIndex < groupCpuCount)
+            {
+                GROUP_AFFINITY affinity = {};
+                affinity.Group = group;
+                affinity.Mask = KAFFINITY(1) << groupCpuIndex;
+                ::SetThreadGroupAffinity(thread.native_handle(), &affinity, nullptr);
+                return;
+            }
+
+            groupCpuIndex -= groupCpuCount;
+        }
+#elif defined(__linux__)
+        const size_t cpuCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        cpuIndex %= cpuCount;
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuIndex, &cpuSet);
+        ::pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+        // 코어 고정을 지원하지 않는 플랫폼
+        (void)thread;
+#endif
+    }
 }
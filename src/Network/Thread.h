@@ -4,21 +4,63 @@
 
 namespace net
 {
+    enum class IoThreadModel
+    {
+        SharedContext,      // 모든 IO 스레드가 하나의 io_context를 공유하고 세션은 strand로 직렬화
+        ContextPerThread,   // 스레드마다 전용 io_context를 두고 세션은 배정된 스레드에서만 실행 (strand 없음)
+    };
+
+    enum class SessionAssignment
+    {
+        RoundRobin,
+        LeastLoaded,
+    };
+
     class IoThreadPool
     {
     public:
-        IoThreadPool();
+        IoThreadPool(
+            size_t threadCount = std::thread::hardware_concurrency(),
+            IoThreadModel threadModel = IoThreadModel::SharedContext,
+            SessionAssignment sessionAssignment = SessionAssignment::LeastLoaded);
 
-        void run(size_t threadCount = std::thread::hardware_concurrency());
+        void run();
         void reset();
         void stop();
         void join();
 
-        asio::io_context& getContext() { return m_context; }
+        // 서비스(resolver, 시그널)가 사용하는 io_context
+        asio::io_context& getContext() { return *m_contexts.front(); }
+
+        // IO 스레드 index가 실행하는 io_context (SharedContext면 모두 같은 io_context)
+        asio::io_context& getThreadContext(size_t threadIndex) { return *m_contexts[threadIndex % m_contexts.size()]; }
+
+        // 새 세션을 배정할 io_context를 선택하고 부하에 반영 (ContextPerThread가 아니면 항상 공유 io_context)
+        asio::io_context& acquireSessionContext();
+
+        // 이미 io_context가 정해진 세션(SO_REUSEPORT acceptor가 수락한 세션)을 부하에 반영
+        void retainSessionContext(const asio::execution_context& context);
+
+        // acquire 또는 retain으로 반영한 세션이 끝나면 (세션을 만들지 못했으면 바로) 호출
+        void releaseSessionContext(const asio::execution_context& context);
+
+        IoThreadModel getThreadModel() const { return m_threadModel; }
+        size_t getThreadCount() const { return m_threadCount; }
 
     private:
-        asio::io_context m_context;
-        asio::executor_work_guard<asio::io_context::executor_type> m_workGuard;
+        static void pinThread(std::thread& thread, size_t cpuIndex);
+        size_t findContextIndex(const asio::execution_context& context) const;
+
+    private:
+        using WorkGuard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+        size_t m_threadCount;
+        IoThreadModel m_threadModel;
+        SessionAssignment m_sessionAssignment;
+        std::vector<std::unique_ptr<asio::io_context>> m_contexts;
+        std::vector<WorkGuard> m_workGuards;
+        std::unique_ptr<std::atomic<size_t>[]> m_sessionCounts;
+        std::atomic<size_t> m_nextContextIndex = 0;
         std::vector<std::thread> m_threads;
     };
 }
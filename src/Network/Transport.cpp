@@ -0,0 +1,125 @@
+﻿#include "Transport.h"
+#include "Session.h"
+#include "Uring.h"
+
+namespace net
+{
+    namespace
+    {
+        // TCP 소켓이면 Nagle 알고리즘을 끈다
+        // 세션은 쌓인 패킷을 모아 한 번에 쓰므로, 켜 두면 마지막 조각이 상대의 지연 ACK를 기다리며 수십 ms 멈춘다
+        void disableNagle(asio::generic::stream_protocol::socket& socket)
+        {
+            asio::error_code error;
+            const auto localEndpoint = socket.local_endpoint(error);
+            if (error)
+            {
+                return;
+            }
+
+            const int family = localEndpoint.protocol().family();
+            if ((family != AF_INET) && (family != AF_INET6))
+            {
+                return;
+            }
+
+            socket.set_option(asio::ip::tcp::no_delay(true), error);
+            if (error)
+            {
+                spdlog::warn("[SocketTransport] TCP_NODELAY 설정 실패: {}", error.message());
+            }
+        }
+    }
+
+    bool isTransportBackendAvailable(TransportBackend backend)
+    {
+        switch (backend)
+        {
+        case TransportBackend::Socket:
+            return true;
+        case TransportBackend::Uring:
+#if defined(BYTEBORNE_HAS_IO_URING)
+            return UringService::isSupported();
+#else
+            return false;
+#endif // BYTEBORNE_HAS_IO_URING
+        }
+
+        return false;
+    }
+
+    asio::any_io_executor SessionTransport::getSessionExecutor(const SessionPtr& session)
+    {
+        return session->m_executor;
+    }
+
+    void SessionTransport::completeRead(const SessionPtr& session, const asio::error_code& error, size_t bytesRead)
+    {
+        session->onRead(error, bytesRead);
+    }
+
+    void SessionTransport::completeWrite(const SessionPtr& session, const asio::error_code& error, size_t bytesWritten)
+    {
+        session->onWritten(error, bytesWritten);
+    }
+
+    SocketTransport::SocketTransport(asio::generic::stream_protocol::socket&& socket)
+        : m_socket(std::move(socket))
+    {
+        // 수락한 소켓과 연결한 소켓 모두 세션이 되기 전에 여기를 지난다
+        disableNagle(m_socket);
+    }
+
+    void SocketTransport::asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer)
+    {
+        m_socket.async_read_some(
+            buffer,
+            asio::bind_executor(
+                getSessionExecutor(session),
+                [session]
+                (const asio::error_code& error, size_t bytesRead)
+                {
+                    completeRead(session, error, bytesRead);
+                }));
+    }
+
+    void SocketTransport::asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers)
+    {
+        asio::async_write(
+            m_socket,
+            buffers,
+            asio::bind_executor(
+                getSessionExecutor(session),
+                [session]
+                (const asio::error_code& error, size_t bytesWritten)
+                {
+                    completeWrite(session, error, bytesWritten);
+                }));
+    }
+
+    void SocketTransport::close(asio::error_code& error)
+    {
+        asio::error_code stepError;
+
+        // 모든 비동기 작업을 취소
+        m_socket.cancel(stepError);
+        if (stepError && !error)
+        {
+            error = stepError;
+        }
+
+        // 송수신 기능 중지
+        m_socket.shutdown(asio::socket_base::shutdown_both, stepError);
+        if (stepError && !error)
+        {
+            error = stepError;
+        }
+
+        // 소켓 닫기
+        m_socket.close(stepError);
+        if (stepError && !error)
+        {
+            error = stepError;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+
+#include <asio.hpp>
+#include <memory>
+#include <vector>
+
+namespace net
+{
+    using SessionPtr = std::shared_ptr<class Session>;
+    using SessionTransportPtr = std::unique_ptr<class SessionTransport>;
+
+    // ServerService가 수락한 연결에 쓰는 전송 계층
+    enum class TransportBackend
+    {
+        Socket, // asio 소켓 (플랫폼 reactor)
+        Uring,  // io_uring (multishot accept/recv, 제공 버퍼), BYTEBORNE_HAS_IO_URING으로 빌드한 Linux에서만
+    };
+
+    // 이 빌드와 실행 중인 커널에서 사용할 수 있는지
+    bool isTransportBackendAvailable(TransportBackend backend);
+
+    // 세션이 바이트 스트림을 주고받는 전송 계층
+    // 비동기 작업은 세션의 실행기 안에서 요청하고, 완료되면 세션의 실행기에서 세션의 완료 핸들러를 호출한다
+    class SessionTransport
+    {
+    public:
+        virtual ~SessionTransport() = default;
+
+        // 전송 계층이 속한 io_context의 실행기
+        virtual asio::any_io_executor getExecutor() = 0;
+
+        virtual void asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer) = 0;
+
+        // buffers를 모두 쓴 뒤에 완료 (buffers는 완료될 때까지 유지돼야 함)
+        virtual void asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers) = 0;
+
+        // 진행 중인 작업을 취소하고 연결을 닫는다 (세션의 실행기에서 호출)
+        virtual void close(asio::error_code& error) = 0;
+        virtual bool isOpen() const = 0;
+
+    protected:
+        static asio::any_io_executor getSessionExecutor(const SessionPtr& session);
+        static void completeRead(const SessionPtr& session, const asio::error_code& error, size_t bytesRead);
+        static void completeWrite(const SessionPtr& session, const asio::error_code& error, size_t bytesWritten);
+    };
+
+    // 스트림 소켓 전송 계층 (TCP 또는 유닉스 도메인 소켓)
+    class SocketTransport final
+        : public SessionTransport
+    {
+    public:
+        explicit SocketTransport(asio::generic::stream_protocol::socket&& socket);
+
+        virtual asio::any_io_executor getExecutor() override { return m_socket.get_executor(); }
+
+        virtual void asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer) override;
+        virtual void asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers) override;
+
+        virtual void close(asio::error_code& error) override;
+        virtual bool isOpen() const override { return m_socket.is_open(); }
+
+    private:
+        asio::generic::stream_protocol::socket m_socket;
+    };
+}
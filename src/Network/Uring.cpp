@@ -0,0 +1,1091 @@
+﻿#include "Uring.h"
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+
+#include "Buffer.h"
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+
+namespace net
+{
+    namespace
+    {
+        constexpr uint16_t BufferGroupId = 0;
+        constexpr uint64_t CancelUserData = 0;  // 취소 요청 자체의 CQE는 무시
+
+        int ioUringSetup(unsigned entries, io_uring_params* params)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int ioUringEnter(int ringFd, unsigned submitCount, unsigned flags)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, submitCount, 0, flags, nullptr, 0));
+        }
+
+        int ioUringRegister(int ringFd, unsigned opcode, const void* argument, unsigned argumentCount)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, argument, argumentCount));
+        }
+
+        asio::error_code makeErrorCode(int result)
+        {
+            return asio::error_code(-result, asio::error::get_system_category());
+        }
+
+        // 제공 버퍼 링의 tail은 첫 항목의 resv 자리에 있다
+        uint16_t* getBufferRingTail(io_uring_buf* ring)
+        {
+            return &ring[0].resv;
+        }
+
+        // SocketTransport와 마찬가지로 TCP 소켓이면 Nagle 알고리즘을 끈다
+        void disableNagle(int fd)
+        {
+            sockaddr_storage address = {};
+            socklen_t addressSize = sizeof(address);
+            if (::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &addressSize) != 0)
+            {
+                return;
+            }
+
+            if ((address.ss_family != AF_INET) && (address.ss_family != AF_INET6))
+            {
+                return;
+            }
+
+            const int enable = 1;
+            if (::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) != 0)
+            {
+                spdlog::warn("[UringTransport] TCP_NODELAY 설정 실패: {}", std::strerror(errno));
+            }
+        }
+    }
+
+    asio::execution_context::id UringService::id;
+
+    UringService::UringService(asio::io_context& ioContext)
+        : asio::execution_context::service(ioContext)
+        , m_ioContext(ioContext)
+        , m_eventDescriptor(ioContext)
+    {
+        setupRing();
+        setupBufferRing();
+
+        // CQE가 들어올 때마다 eventfd에 알려 reactor가 깨우도록 등록
+        const int eventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (eventFd < 0)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "eventfd");
+        }
+
+        m_eventDescriptor.assign(eventFd);
+
+        if (ioUringRegister(m_ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "IORING_REGISTER_EVENTFD");
+        }
+    }
+
+    UringService::~UringService()
+    {
+        if (m_entries)
+        {
+            ::munmap(m_entries, m_entriesSize);
+        }
+
+        if (m_ringMemory)
+        {
+            ::munmap(m_ringMemory, m_ringMemorySize);
+        }
+
+        if (m_bufferRing)
+        {
+            ::munmap(m_bufferRing, m_bufferRingSize);
+        }
+
+        if (0 <= m_ringFd)
+        {
+            ::close(m_ringFd);
+        }
+    }
+
+    bool UringService::isSupported()
+    {
+        static const bool s_supported = []()
+        {
+            io_uring_params params = {};
+            const int ringFd = ioUringSetup(8, &params);
+            if (ringFd < 0)
+            {
+                spdlog::info("[UringService] io_uring을 사용할 수 없음: {}", std::strerror(errno));
+                return false;
+            }
+
+            // 링 하나를 mmap 하나로 매핑하고 CQ가 넘쳐도 CQE를 버리지 않아야 한다
+            bool supported = ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) && ((params.features & IORING_FEAT_NODROP) != 0);
+
+            // multishot recv와 같은 커널(6.0)에 들어온 SEND_ZC로 multishot 지원을 확인한다 (제공 버퍼 링과 multishot accept는 5.19)
+            constexpr size_t ProbeOpCount = 256;
+            std::vector<uint8_t> probeMemory(sizeof(io_uring_probe) + ProbeOpCount * sizeof(io_uring_probe_op), 0);
+            auto* probe = reinterpret_cast<io_uring_probe*>(probeMemory.data());
+            if (supported && (ioUringRegister(ringFd, IORING_REGISTER_PROBE, probe, ProbeOpCount) == 0))
+            {
+                for (const uint8_t opcode : { IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SENDMSG, IORING_OP_ASYNC_CANCEL, IORING_OP_SEND_ZC })
+                {
+                    if ((probe->last_op < opcode) || ((probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0))
+                    {
+                        supported = false;
+                    }
+                }
+            }
+            else
+            {
+                supported = false;
+            }
+
+            ::close(ringFd);
+
+            if (!supported)
+            {
+                spdlog::info("[UringService] 커널이 multishot accept/recv 또는 제공 버퍼 링을 지원하지 않음");
+            }
+
+            return supported;
+        }();
+
+        return s_supported;
+    }
+
+    void UringService::setupRing()
+    {
+        io_uring_params params = {};
+        params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL;
+        params.cq_entries = EntryCount * 4;
+
+        m_ringFd = ioUringSetup(EntryCount, &params);
+        if (m_ringFd < 0)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "io_uring_setup");
+        }
+
+        const size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        const size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        m_ringMemorySize = std::max(sqSize, cqSize);
+
+        void* ringMemory = ::mmap(nullptr, m_ringMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+        if (ringMemory == MAP_FAILED)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "mmap io_uring");
+        }
+        m_ringMemory = ringMemory;
+
+        m_entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* entries = ::mmap(nullptr, m_entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+        if (entries == MAP_FAILED)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "mmap io_uring sqes");
+        }
+        m_entries = static_cast<io_uring_sqe*>(entries);
+
+        uint8_t* base = static_cast<uint8_t*>(m_ringMemory);
+        m_sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+        m_sqFlags = reinterpret_cast<unsigned*>(base + params.sq_off.flags);
+        m_sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+        m_sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+        m_sqEntryCount = params.sq_entries;
+        m_sqLocalTail = *m_sqTail;
+        m_cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+        m_cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    }
+
+    void UringService::setupBufferRing()
+    {
+        static_assert((BufferCount & (BufferCount - 1)) == 0, "the provided buffer ring size must be a power of two");
+        static_assert(BufferSize <= ReceiveBuffer::DefaultSize, "a provided buffer must fit in a single read request");
+
+        // 링은 페이지 정렬돼야 하므로 mmap으로 할당
+        m_bufferRingSize = BufferCount * sizeof(io_uring_buf);
+        void* bufferRing = ::mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (bufferRing == MAP_FAILED)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "mmap buffer ring");
+        }
+        m_bufferRing = static_cast<io_uring_buf*>(bufferRing);
+
+        io_uring_buf_reg registration = {};
+        registration.ring_addr = reinterpret_cast<uint64_t>(m_bufferRing);
+        registration.ring_entries = BufferCount;
+        registration.bgid = BufferGroupId;
+        if (ioUringRegister(m_ringFd, IORING_REGISTER_PBUF_RING, &registration, 1) < 0)
+        {
+            throw asio::system_error(makeErrorCode(-errno), "IORING_REGISTER_PBUF_RING");
+        }
+
+        // 버퍼 메모리는 커널이 처음 채울 때 페이지가 잡힌다
+        m_buffers.reset(new uint8_t[static_cast<size_t>(BufferCount) * BufferSize]);
+        for (uint32_t bufferId = 0; bufferId < BufferCount; ++bufferId)
+        {
+            recycleBuffer(static_cast<uint16_t>(bufferId));
+        }
+    }
+
+    void UringService::shutdown()
+    {
+        // io_context가 사라지면 남은 작업의 CQE는 오지 않으므로 작업이 잡고 있던 객체를 놓는다
+        // 객체가 소멸하면서 버퍼를 돌려주므로 잠금 밖에서 놓는다
+        std::vector<std::shared_ptr<void>> owners;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (UringOperation* operation = m_operations; operation; operation = operation->m_next)
+            {
+                owners.push_back(std::move(operation->m_owner));
+            }
+
+            m_operations = nullptr;
+            m_operationCount = 0;
+        }
+
+        owners.clear();
+    }
+
+    void UringService::submitAccept(UringOperation& operation, std::shared_ptr<void> owner, int fd)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        io_uring_sqe* entry = acquireEntry();
+        entry->opcode = IORING_OP_ACCEPT;
+        entry->fd = fd;
+        entry->ioprio = IORING_ACCEPT_MULTISHOT;
+        entry->accept_flags = SOCK_CLOEXEC;
+        entry->user_data = reinterpret_cast<uint64_t>(&operation);
+
+        track(operation, std::move(owner));
+    }
+
+    void UringService::submitReceive(UringOperation& operation, std::shared_ptr<void> owner, int fd)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        io_uring_sqe* entry = acquireEntry();
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = fd;
+        entry->ioprio = IORING_RECV_MULTISHOT;
+        entry->flags = IOSQE_BUFFER_SELECT;
+        entry->buf_group = BufferGroupId;
+        entry->user_data = reinterpret_cast<uint64_t>(&operation);
+
+        track(operation, std::move(owner));
+    }
+
+    void UringService::submitReceive(UringOperation& operation, std::shared_ptr<void> owner, int fd, void* data, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        io_uring_sqe* entry = acquireEntry();
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = fd;
+        entry->addr = reinterpret_cast<uint64_t>(data);
+        entry->len = static_cast<uint32_t>(size);
+        entry->user_data = reinterpret_cast<uint64_t>(&operation);
+
+        track(operation, std::move(owner));
+    }
+
+    void UringService::submitSend(UringOperation& operation, std::shared_ptr<void> owner, int fd, const msghdr* message)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        io_uring_sqe* entry = acquireEntry();
+        entry->opcode = IORING_OP_SENDMSG;
+        entry->fd = fd;
+        entry->addr = reinterpret_cast<uint64_t>(message);
+        entry->len = 1;
+        entry->msg_flags = MSG_NOSIGNAL;
+        entry->user_data = reinterpret_cast<uint64_t>(&operation);
+
+        track(operation, std::move(owner));
+    }
+
+    void UringService::submitCancel(const UringOperation& operation)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        io_uring_sqe* entry = acquireEntry();
+        entry->opcode = IORING_OP_ASYNC_CANCEL;
+        entry->fd = -1;
+        entry->addr = reinterpret_cast<uint64_t>(&operation);
+        entry->user_data = CancelUserData;
+
+        scheduleFlush();
+    }
+
+    void UringService::recycleBuffer(uint16_t bufferId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        io_uring_buf& buffer = m_bufferRing[m_bufferTail & (BufferCount - 1)];
+        buffer.addr = reinterpret_cast<uint64_t>(m_buffers.get() + static_cast<size_t>(bufferId) * BufferSize);
+        buffer.len = static_cast<uint32_t>(BufferSize);
+        buffer.bid = bufferId;
+
+        ++m_bufferTail;
+        __atomic_store_n(getBufferRingTail(m_bufferRing), m_bufferTail, __ATOMIC_RELEASE);
+    }
+
+    UringStats UringService::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    io_uring_sqe* UringService::acquireEntry()
+    {
+        if (m_sqEntryCount <= m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE))
+        {
+            // SQ가 가득 차면 지금까지 쌓인 항목을 먼저 제출
+            submitEntries();
+        }
+
+        const unsigned index = m_sqLocalTail & m_sqMask;
+        io_uring_sqe* entry = &m_entries[index];
+        std::memset(entry, 0, sizeof(io_uring_sqe));
+        m_sqArray[index] = index;
+        ++m_sqLocalTail;
+
+        return entry;
+    }
+
+    void UringService::track(UringOperation& operation, std::shared_ptr<void>&& owner)
+    {
+        assert(!operation.m_owner);
+
+        operation.m_owner = std::move(owner);
+        operation.m_prev = nullptr;
+        operation.m_next = m_operations;
+        if (m_operations)
+        {
+            m_operations->m_prev = &operation;
+        }
+        m_operations = &operation;
+        ++m_operationCount;
+
+        scheduleFlush();
+    }
+
+    void UringService::scheduleFlush()
+    {
+        if (m_flushScheduled)
+        {
+            return;
+        }
+
+        m_flushScheduled = true;
+        asio::post(
+            m_ioContext,
+            [this]()
+            {
+                flush();
+            });
+    }
+
+    void UringService::submitEntries(unsigned flags)
+    {
+        __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+
+        const unsigned submitCount = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        if ((submitCount == 0) && (flags == 0))
+        {
+            return;
+        }
+
+        // CQ가 넘쳐 커널에 남은 CQE가 있으면 제출하면서 CQ로 옮기게 한다
+        if (__atomic_load_n(m_sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW)
+        {
+            flags |= IORING_ENTER_GETEVENTS;
+        }
+
+        int result = 0;
+        do
+        {
+            result = ioUringEnter(m_ringFd, submitCount, flags);
+        } while ((result < 0) && (errno == EINTR));
+
+        ++m_stats.enterCalls;
+        if (result < 0)
+        {
+            // EBUSY/EAGAIN이면 남은 항목은 다음 flush에서 다시 제출된다
+            spdlog::warn("[UringService] io_uring_enter 실패: {}", std::strerror(errno));
+            return;
+        }
+
+        m_stats.submittedEntries += static_cast<uint64_t>(result);
+    }
+
+    void UringService::asyncWaitForCompletions()
+    {
+        if (m_waiting || (m_operationCount == 0))
+        {
+            // 진행 중인 작업이 없으면 기다리지 않아야 io_context가 일이 없을 때 끝날 수 있다
+            return;
+        }
+
+        m_waiting = true;
+        m_eventDescriptor.async_wait(
+            asio::posix::stream_descriptor::wait_read,
+            [this](const asio::error_code& error)
+            {
+                onCompletionsReady(error);
+            });
+    }
+
+    void UringService::reapCompletions(std::vector<Completion>& completions)
+    {
+        while (true)
+        {
+            unsigned head = *m_cqHead;
+            const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+            for (; head != tail; ++head)
+            {
+                const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                ++m_stats.completions;
+
+                if (cqe.user_data == CancelUserData)
+                {
+                    continue;
+                }
+
+                if (cqe.res == -ENOBUFS)
+                {
+                    ++m_stats.bufferExhausted;
+                }
+
+                Completion& completion = completions.emplace_back();
+                completion.operation = reinterpret_cast<UringOperation*>(cqe.user_data);
+                completion.result = cqe.res;
+                completion.flags = cqe.flags;
+
+                if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+                {
+                    // 마지막 CQE면 목록에서 빼고, 작업을 담은 객체는 완료를 처리할 때까지 유지
+                    UringOperation* operation = completion.operation;
+                    completion.owner = std::move(operation->m_owner);
+
+                    if (operation->m_prev)
+                    {
+                        operation->m_prev->m_next = operation->m_next;
+                    }
+                    else
+                    {
+                        m_operations = operation->m_next;
+                    }
+
+                    if (operation->m_next)
+                    {
+                        operation->m_next->m_prev = operation->m_prev;
+                    }
+
+                    operation->m_prev = nullptr;
+                    operation->m_next = nullptr;
+                    --m_operationCount;
+                }
+            }
+
+            __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+            if ((__atomic_load_n(m_sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) == 0)
+            {
+                break;
+            }
+
+            // 넘친 CQE를 CQ로 옮긴 뒤 다시 거둔다
+            submitEntries(IORING_ENTER_GETEVENTS);
+        }
+    }
+
+    void UringService::flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_flushScheduled = false;
+
+        // 제출한 작업의 완료를 놓치지 않도록 제출하기 전에 기다리기 시작
+        asyncWaitForCompletions();
+        submitEntries();
+    }
+
+    void UringService::onCompletionsReady(const asio::error_code& error)
+    {
+        thread_local std::vector<Completion> t_completions;
+        std::vector<Completion> completions = std::move(t_completions);
+        completions.clear();
+
+        // 먼저 거둔 스레드가 전달을 마치기 전에 다른 스레드가 뒤의 CQE를 거둬 먼저 전달하지 않도록 한다
+        std::unique_lock<std::mutex> completionLock(m_completionMutex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_waiting = false;
+            if (error)
+            {
+                if (error != asio::error::operation_aborted)
+                {
+                    spdlog::error("[UringService] eventfd 대기 실패: {}", error.message());
+                }
+
+                // 작업이 없어 취소한 사이에 새 작업이 들어왔으면 다시 기다린다
+                asyncWaitForCompletions();
+                return;
+            }
+
+            uint64_t value = 0;
+            [[maybe_unused]] const ssize_t bytesRead = ::read(m_eventDescriptor.native_handle(), &value, sizeof(value));
+            ++m_stats.wakeups;
+
+            // eventfd 알림은 edge로 전달되므로 CQ를 비우기 전에 다음 대기를 건다
+            asyncWaitForCompletions();
+            reapCompletions(completions);
+        }
+
+        for (Completion& completion : completions)
+        {
+            completion.operation->complete(completion.result, completion.flags);
+        }
+
+        completionLock.unlock();
+
+        completions.clear();
+        t_completions = std::move(completions);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if ((m_operationCount == 0) && m_waiting)
+        {
+            asio::error_code cancelError;
+            m_eventDescriptor.cancel(cancelError);
+        }
+    }
+
+    struct UringTransport::Socket
+        : public std::enable_shared_from_this<Socket>
+    {
+        enum class ReceiveState
+        {
+            Idle,
+            Multishot,  // 제공 버퍼로 계속 수신
+            Cancelling, // 흐름 제어나 닫기로 multishot 수신을 취소하는 중
+            Direct,     // 제공 버퍼가 떨어져 세션의 수신 버퍼로 한 번 수신
+        };
+
+        // 제공 버퍼에 받아 두고 아직 세션에 넘기지 않은 데이터
+        struct ReceivedBuffer
+        {
+            uint16_t bufferId = 0;
+            size_t offset = 0;
+            size_t size = 0;
+        };
+
+        struct ReceiveOperation final
+            : public UringOperation
+        {
+            Socket& socket;
+
+            explicit ReceiveOperation(Socket& socket) : socket(socket) {}
+
+            virtual void complete(int result, uint32_t flags) override
+            {
+                asio::dispatch(
+                    socket.sessionExecutor,
+                    [owner = socket.shared_from_this(), result, flags]()
+                    {
+                        owner->onReceived(result, flags);
+                    });
+            }
+        };
+
+        struct SendOperation final
+            : public UringOperation
+        {
+            Socket& socket;
+
+            explicit SendOperation(Socket& socket) : socket(socket) {}
+
+            virtual void complete(int result, uint32_t /*flags*/) override
+            {
+                asio::dispatch(
+                    socket.sessionExecutor,
+                    [owner = socket.shared_from_this(), result]()
+                    {
+                        owner->onSent(result);
+                    });
+            }
+        };
+
+        UringService& service;
+        int fd;
+        bool closed = false;
+
+        // 첫 요청에서 한 번만 설정하고 바꾸지 않는다 (완료를 거두는 IO 스레드가 읽는다)
+        asio::any_io_executor sessionExecutor;
+
+        // 아래는 세션의 실행기에서만 사용
+        ReceiveOperation receiveOperation{ *this };
+        ReceiveState receiveState = ReceiveState::Idle;
+        std::deque<ReceivedBuffer> receivedBuffers;
+        size_t receivedBytes = 0;
+        asio::error_code receiveError;  // 받아 둔 데이터를 넘긴 뒤 전달할 eof 또는 에러
+        bool bufferExhausted = false;
+        SessionPtr readSession;         // 진행 중인 읽기 요청
+        asio::mutable_buffer readBuffer;
+
+        SendOperation sendOperation{ *this };
+        SessionPtr sendSession;         // 진행 중인 쓰기 요청
+        std::vector<iovec> sendVectors;
+        msghdr sendMessage = {};
+        size_t sendIndex = 0;
+        size_t bytesSent = 0;
+
+        Socket(UringService& service, int fd)
+            : service(service)
+            , fd(fd)
+        {}
+
+        ~Socket()
+        {
+            for (const ReceivedBuffer& buffer : receivedBuffers)
+            {
+                service.recycleBuffer(buffer.bufferId);
+            }
+
+            ::close(fd);
+        }
+
+        void startReceive()
+        {
+            if (closed || receiveError || (receiveState != ReceiveState::Idle))
+            {
+                return;
+            }
+
+            if (bufferExhausted)
+            {
+                // 받아 둔 데이터를 모두 넘긴 뒤에만 세션의 수신 버퍼에 바로 받아 순서를 지킨다
+                if (readSession && receivedBuffers.empty())
+                {
+                    receiveState = ReceiveState::Direct;
+                    service.submitReceive(receiveOperation, shared_from_this(), fd, readBuffer.data(), readBuffer.size());
+                }
+                return;
+            }
+
+            if (receivedBytes < MaxBufferedBytes)
+            {
+                receiveState = ReceiveState::Multishot;
+                service.submitReceive(receiveOperation, shared_from_this(), fd);
+            }
+        }
+
+        void onReceived(int result, uint32_t flags)
+        {
+            const bool more = (flags & IORING_CQE_F_MORE) != 0;
+
+            if (receiveState == ReceiveState::Direct)
+            {
+                receiveState = ReceiveState::Idle;
+                bufferExhausted = false;
+
+                if (0 < result)
+                {
+                    completeRead(asio::error_code(), static_cast<size_t>(result));
+                }
+                else
+                {
+                    receiveError = (result == 0) ? asio::error::eof : makeErrorCode(result);
+                    deliverRead();
+                }
+
+                startReceive();
+                return;
+            }
+
+            if (0 < result)
+            {
+                const uint16_t bufferId = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+                if (closed)
+                {
+                    service.recycleBuffer(bufferId);
+                }
+                else
+                {
+                    receivedBuffers.push_back(ReceivedBuffer{ bufferId, 0, static_cast<size_t>(result) });
+                    receivedBytes += static_cast<size_t>(result);
+                }
+            }
+            else if (result == 0)
+            {
+                receiveError = asio::error::eof;
+            }
+            else if (result == -ENOBUFS)
+            {
+                bufferExhausted = true;
+            }
+            else if (result != -ECANCELED)
+            {
+                receiveError = makeErrorCode(result);
+            }
+
+            if (!more)
+            {
+                receiveState = ReceiveState::Idle;
+            }
+            else if ((receiveState == ReceiveState::Multishot) && (MaxBufferedBytes <= receivedBytes))
+            {
+                // 세션이 따라오지 못하면 더 받지 않고 소켓 버퍼에 남겨 상대의 송신을 늦춘다
+                receiveState = ReceiveState::Cancelling;
+                service.submitCancel(receiveOperation);
+            }
+
+            deliverRead();
+            startReceive();
+        }
+
+        // 받아 둔 데이터를 진행 중인 읽기 요청에 넘긴다
+        void deliverRead()
+        {
+            if (!readSession)
+            {
+                return;
+            }
+
+            if (closed)
+            {
+                completeRead(asio::error::operation_aborted, 0);
+                return;
+            }
+
+            uint8_t* destination = static_cast<uint8_t*>(readBuffer.data());
+            size_t copied = 0;
+            while (!receivedBuffers.empty() && (copied < readBuffer.size()))
+            {
+                ReceivedBuffer& buffer = receivedBuffers.front();
+                const size_t size = std::min(buffer.size - buffer.offset, readBuffer.size() - copied);
+                std::memcpy(destination + copied, service.getBuffer(buffer.bufferId) + buffer.offset, size);
+
+                copied += size;
+                buffer.offset += size;
+                if (buffer.offset == buffer.size)
+                {
+                    service.recycleBuffer(buffer.bufferId);
+                    receivedBuffers.pop_front();
+                }
+            }
+
+            receivedBytes -= copied;
+
+            if (0 < copied)
+            {
+                completeRead(asio::error_code(), copied);
+            }
+            else if (receiveError)
+            {
+                completeRead(receiveError, 0);
+            }
+        }
+
+        void completeRead(const asio::error_code& error, size_t bytesRead)
+        {
+            SessionPtr session = std::move(readSession);
+            readSession.reset();
+            readBuffer = asio::mutable_buffer();
+
+            UringTransport::completeRead(session, error, bytesRead);
+        }
+
+        void onSent(int result)
+        {
+            if (result <= 0)
+            {
+                asio::error_code error;
+                if (closed)
+                {
+                    error = asio::error::operation_aborted;
+                }
+                else
+                {
+                    error = (result == 0) ? asio::error_code(asio::error::connection_reset) : makeErrorCode(result);
+                }
+
+                completeWrite(error);
+                return;
+            }
+
+            bytesSent += static_cast<size_t>(result);
+
+            // 일부만 보냈으면 남은 부분부터 다시 제출
+            size_t remaining = static_cast<size_t>(result);
+            while ((sendIndex < sendVectors.size()) && (sendVectors[sendIndex].iov_len <= remaining))
+            {
+                remaining -= sendVectors[sendIndex].iov_len;
+                ++sendIndex;
+            }
+
+            if (sendIndex == sendVectors.size())
+            {
+                completeWrite(asio::error_code());
+                return;
+            }
+
+            iovec& vector = sendVectors[sendIndex];
+            vector.iov_base = static_cast<uint8_t*>(vector.iov_base) + remaining;
+            vector.iov_len -= remaining;
+
+            submitSend();
+        }
+
+        void submitSend()
+        {
+            sendMessage.msg_iov = sendVectors.data() + sendIndex;
+            sendMessage.msg_iovlen = sendVectors.size() - sendIndex;
+            service.submitSend(sendOperation, shared_from_this(), fd, &sendMessage);
+        }
+
+        void completeWrite(const asio::error_code& error)
+        {
+            SessionPtr session = std::move(sendSession);
+            sendSession.reset();
+
+            UringTransport::completeWrite(session, error, bytesSent);
+        }
+
+        void close()
+        {
+            if (closed)
+            {
+                return;
+            }
+
+            closed = true;
+
+            // 수신은 0 바이트로, 송신은 에러로 끝나게 한 뒤 진행 중인 작업을 취소
+            // fd는 마지막 작업이 끝나 소켓 상태가 소멸할 때 닫는다 (취소 전에 fd 번호가 재사용되지 않도록)
+            ::shutdown(fd, SHUT_RDWR);
+
+            if ((receiveState == ReceiveState::Multishot) || (receiveState == ReceiveState::Direct))
+            {
+                if (receiveState == ReceiveState::Multishot)
+                {
+                    receiveState = ReceiveState::Cancelling;
+                }
+                service.submitCancel(receiveOperation);
+            }
+
+            if (sendSession)
+            {
+                service.submitCancel(sendOperation);
+            }
+
+            for (const ReceivedBuffer& buffer : receivedBuffers)
+            {
+                service.recycleBuffer(buffer.bufferId);
+            }
+            receivedBuffers.clear();
+            receivedBytes = 0;
+
+            if (readSession && (receiveState != ReceiveState::Direct))
+            {
+                // 소켓과 마찬가지로 취소된 읽기는 세션의 실행기에 post
+                asio::post(
+                    sessionExecutor,
+                    [owner = shared_from_this()]()
+                    {
+                        owner->deliverRead();
+                    });
+            }
+        }
+    };
+
+    UringTransport::UringTransport(asio::io_context& ioContext, int fd)
+        : m_executor(ioContext.get_executor())
+        , m_socket(std::make_shared<Socket>(asio::use_service<UringService>(ioContext), fd))
+    {
+        disableNagle(fd);
+    }
+
+    UringTransport::~UringTransport()
+    {
+        // 세션 없이 사라지면 진행 중인 작업이 없으므로 닫기만 한다
+        m_socket->close();
+    }
+
+    void UringTransport::asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer)
+    {
+        Socket& socket = *m_socket;
+        assert(!socket.readSession);
+
+        if (!socket.sessionExecutor)
+        {
+            // 작업을 제출하기 전에 설정하므로 이후 완료를 거두는 스레드와 경쟁하지 않는다
+            socket.sessionExecutor = getSessionExecutor(session);
+        }
+        assert(socket.sessionExecutor == getSessionExecutor(session));
+        socket.readSession = session;
+        socket.readBuffer = buffer;
+
+        if (socket.closed || !socket.receivedBuffers.empty() || socket.receiveError)
+        {
+            asio::post(
+                socket.sessionExecutor,
+                [owner = m_socket]()
+                {
+                    owner->deliverRead();
+                    owner->startReceive();
+                });
+            return;
+        }
+
+        socket.startReceive();
+    }
+
+    void UringTransport::asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers)
+    {
+        Socket& socket = *m_socket;
+        assert(!socket.sendSession);
+
+        if (!socket.sessionExecutor)
+        {
+            socket.sessionExecutor = getSessionExecutor(session);
+        }
+        assert(socket.sessionExecutor == getSessionExecutor(session));
+        socket.sendSession = session;
+        socket.sendVectors.clear();
+        for (const asio::const_buffer& buffer : buffers)
+        {
+            socket.sendVectors.push_back(iovec{ const_cast<void*>(buffer.data()), buffer.size() });
+        }
+        socket.sendIndex = 0;
+        socket.bytesSent = 0;
+
+        if (socket.closed)
+        {
+            asio::post(
+                socket.sessionExecutor,
+                [owner = m_socket]()
+                {
+                    owner->completeWrite(asio::error::operation_aborted);
+                });
+            return;
+        }
+
+        socket.submitSend();
+    }
+
+    void UringTransport::close(asio::error_code& error)
+    {
+        // shutdown 실패(이미 끊긴 연결)는 닫기 결과에 영향이 없다
+        error.clear();
+        m_socket->close();
+    }
+
+    bool UringTransport::isOpen() const
+    {
+        return !m_socket->closed;
+    }
+
+    UringAcceptor::UringAcceptor(asio::io_context& ioContext, int listenFd, asio::any_io_executor executor, AcceptHandler handler)
+        : m_service(asio::use_service<UringService>(ioContext))
+        , m_listenFd(listenFd)
+        , m_executor(std::move(executor))
+        , m_handler(std::move(handler))
+    {
+        assert(m_handler);
+    }
+
+    void UringAcceptor::start()
+    {
+        m_running = true;
+        submit();
+    }
+
+    void UringAcceptor::cancel()
+    {
+        m_running = false;
+        if (m_submitted)
+        {
+            // 링의 accept가 리스닝 소켓을 붙잡고 있으므로, 취소가 처리되기 전에 소켓을 닫아도 포트가 바로 풀리도록 리스닝을 멈춘다
+            ::shutdown(m_listenFd, SHUT_RDWR);
+            m_service.submitCancel(*this);
+        }
+    }
+
+    void UringAcceptor::stop()
+    {
+        m_running = false;
+        if (m_submitted)
+        {
+            m_service.submitCancel(*this);
+        }
+    }
+
+    void UringAcceptor::complete(int result, uint32_t flags)
+    {
+        asio::dispatch(
+            m_executor,
+            [self = shared_from_this(), result, flags]()
+            {
+                self->onCompleted(result, flags);
+            });
+    }
+
+    void UringAcceptor::submit()
+    {
+        m_submitted = true;
+        m_service.submitAccept(*this, shared_from_this(), m_listenFd);
+    }
+
+    void UringAcceptor::onCompleted(int result, uint32_t flags)
+    {
+        if ((flags & IORING_CQE_F_MORE) == 0)
+        {
+            m_submitted = false;
+        }
+
+        if (!m_running)
+        {
+            if (0 <= result)
+            {
+                // 취소하기 전에 수락된 소켓
+                ::close(result);
+            }
+            return;
+        }
+
+        if (0 <= result)
+        {
+            m_handler(asio::error_code(), result);
+        }
+        else if (result != -ECANCELED)
+        {
+            m_handler(makeErrorCode(result), -1);
+        }
+
+        // multishot accept가 끝났으면 (에러나 커널 사정) 다시 건다
+        if (m_running && !m_submitted)
+        {
+            submit();
+        }
+    }
+}
+
+#endif // BYTEBORNE_HAS_IO_URING
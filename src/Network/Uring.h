@@ -0,0 +1,214 @@
+﻿#pragma once
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+
+#include <asio.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <sys/socket.h>
+#include "Transport.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf;
+
+namespace net
+{
+    struct UringStats
+    {
+        uint64_t enterCalls = 0;        // io_uring_enter 호출 수
+        uint64_t submittedEntries = 0;  // 제출한 SQE 수
+        uint64_t completions = 0;       // 거둔 CQE 수
+        uint64_t wakeups = 0;           // eventfd로 깨어나 CQ를 확인한 횟수 (eventfd 읽기 한 번씩)
+        uint64_t bufferExhausted = 0;   // 제공 버퍼가 떨어져 multishot 수신이 끝난 횟수
+    };
+
+    // io_uring에 제출한 작업 하나 (multishot 작업은 마지막 CQE까지 하나의 작업)
+    class UringOperation
+    {
+    public:
+        virtual ~UringOperation() = default;
+
+        // CQE를 거둔 IO 스레드에서 호출 (flags에 IORING_CQE_F_MORE가 없으면 작업이 끝났다)
+        virtual void complete(int result, uint32_t flags) = 0;
+
+    private:
+        friend class UringService;
+
+        std::shared_ptr<void> m_owner;      // 작업이 끝날 때까지 작업을 담은 객체를 유지
+        UringOperation* m_prev = nullptr;   // 진행 중인 작업 목록
+        UringOperation* m_next = nullptr;
+    };
+
+    // io_context마다 하나씩 두는 io_uring 인스턴스 (asio::use_service로 얻는다)
+    // 완료를 알리는 eventfd를 io_context의 reactor에서 기다리므로 asio의 다른 비동기 작업과 같은 IO 스레드에서 섞여 실행된다
+    // 핸들러들이 쌓은 SQE는 post한 flush에서 io_uring_enter 한 번으로 제출한다
+    class UringService
+        : public asio::execution_context::service
+    {
+    public:
+        static asio::execution_context::id id;
+
+        static constexpr unsigned EntryCount = 4096;    // SQ 크기 (CQ는 4배)
+        static constexpr uint16_t BufferCount = 4096;   // 수신 제공 버퍼 수 (2의 거듭제곱)
+        static constexpr size_t BufferSize = 4096;
+
+    public:
+        explicit UringService(asio::io_context& ioContext);
+        virtual ~UringService() override;
+
+        UringService(const UringService&) = delete;
+        UringService& operator=(const UringService&) = delete;
+
+        // 실행 중인 커널이 multishot accept/recv와 제공 버퍼 링을 지원하는지 (처음 호출할 때 한 번 확인)
+        static bool isSupported();
+
+        // owner는 작업의 마지막 CQE를 처리할 때까지 유지한다 (operation은 owner 안에 있어야 함)
+        void submitAccept(UringOperation& operation, std::shared_ptr<void> owner, int fd);
+        void submitReceive(UringOperation& operation, std::shared_ptr<void> owner, int fd);
+        void submitReceive(UringOperation& operation, std::shared_ptr<void> owner, int fd, void* data, size_t size);
+        void submitSend(UringOperation& operation, std::shared_ptr<void> owner, int fd, const msghdr* message);
+
+        // 취소된 작업은 -ECANCELED(또는 이미 받은 결과)로 마지막 CQE를 받는다
+        void submitCancel(const UringOperation& operation);
+
+        // multishot 수신이 CQE에 담아 준 제공 버퍼 (다 읽으면 recycleBuffer로 링에 돌려준다)
+        const uint8_t* getBuffer(uint16_t bufferId) const { return m_buffers.get() + static_cast<size_t>(bufferId) * BufferSize; }
+        void recycleBuffer(uint16_t bufferId);
+
+        UringStats getStats() const;
+
+    private:
+        struct Completion
+        {
+            UringOperation* operation = nullptr;
+            int result = 0;
+            uint32_t flags = 0;
+            std::shared_ptr<void> owner;    // 마지막 CQE면 작업에서 넘겨받는다
+        };
+
+        virtual void shutdown() override;
+
+        void setupRing();
+        void setupBufferRing();
+
+        // 아래는 m_mutex를 잡고 호출
+        io_uring_sqe* acquireEntry();
+        void track(UringOperation& operation, std::shared_ptr<void>&& owner);
+        void scheduleFlush();
+        void submitEntries(unsigned flags = 0);
+        void asyncWaitForCompletions();
+        void reapCompletions(std::vector<Completion>& completions);
+
+        void flush();
+        void onCompletionsReady(const asio::error_code& error);
+
+    private:
+        asio::io_context& m_ioContext;
+        asio::posix::stream_descriptor m_eventDescriptor;
+
+        int m_ringFd = -1;
+        void* m_ringMemory = nullptr;
+        size_t m_ringMemorySize = 0;
+        io_uring_sqe* m_entries = nullptr;
+        size_t m_entriesSize = 0;
+
+        // 커널과 공유하는 SQ/CQ 링
+        unsigned* m_sqHead = nullptr;
+        unsigned* m_sqTail = nullptr;
+        unsigned* m_sqFlags = nullptr;
+        unsigned* m_sqArray = nullptr;
+        unsigned m_sqMask = 0;
+        unsigned m_sqEntryCount = 0;
+        unsigned m_sqLocalTail = 0;     // 채웠지만 아직 커널에 알리지 않은 위치
+        unsigned* m_cqHead = nullptr;
+        unsigned* m_cqTail = nullptr;
+        io_uring_cqe* m_cqes = nullptr;
+        unsigned m_cqMask = 0;
+
+        // 수신 제공 버퍼 링
+        io_uring_buf* m_bufferRing = nullptr;
+        size_t m_bufferRingSize = 0;
+        std::unique_ptr<uint8_t[]> m_buffers;
+        uint16_t m_bufferTail = 0;
+
+        // SharedContext면 여러 IO 스레드가 같은 링을 쓰므로 링과 작업 목록은 잠금 안에서 다룬다
+        mutable std::mutex m_mutex;
+        UringOperation* m_operations = nullptr;
+        size_t m_operationCount = 0;
+        bool m_waiting = false;
+        bool m_flushScheduled = false;
+        UringStats m_stats;
+
+        // CQE를 거두고 작업에 전달하는 동안 잡아, 여러 IO 스레드가 깨어나도 CQ 순서대로 전달한다 (수신 데이터의 순서)
+        std::mutex m_completionMutex;
+    };
+
+    // 수락한 소켓을 io_uring으로 주고받는 전송 계층
+    // 수신은 multishot recv가 제공 버퍼에 받아 두고 읽기 요청이 오면 세션의 수신 버퍼로 복사한다
+    // 세션이 읽지 않아 쌓인 데이터가 MaxBufferedBytes를 넘으면 수신을 멈춰 소켓 버퍼와 TCP 윈도우로 흐름을 제어한다
+    class UringTransport final
+        : public SessionTransport
+    {
+    public:
+        static constexpr size_t MaxBufferedBytes = 16 * 1024;
+
+    public:
+        // 연결된 소켓 fd의 소유권을 넘겨받는다
+        UringTransport(asio::io_context& ioContext, int fd);
+        virtual ~UringTransport() override;
+
+        virtual asio::any_io_executor getExecutor() override { return m_executor; }
+
+        virtual void asyncReadSome(const SessionPtr& session, asio::mutable_buffer buffer) override;
+        virtual void asyncWrite(const SessionPtr& session, const std::vector<asio::const_buffer>& buffers) override;
+
+        virtual void close(asio::error_code& error) override;
+        virtual bool isOpen() const override;
+
+    private:
+        // 진행 중인 작업과 함께 마지막 CQE까지 유지되는 소켓 상태
+        struct Socket;
+
+        asio::io_context::executor_type m_executor;
+        std::shared_ptr<Socket> m_socket;
+    };
+
+    // 리스닝 소켓에 multishot accept 하나를 걸어 두고 수락할 때마다 handler를 executor에서 호출
+    class UringAcceptor final
+        : public UringOperation
+        , public std::enable_shared_from_this<UringAcceptor>
+    {
+    public:
+        // 수락한 소켓 fd의 소유권은 핸들러로 넘어간다 (에러면 fd는 -1)
+        using AcceptHandler = std::function<void(const asio::error_code& error, int fd)>;
+
+    public:
+        UringAcceptor(asio::io_context& ioContext, int listenFd, asio::any_io_executor executor, AcceptHandler handler);
+
+        // executor에서 호출, cancel() 뒤에는 핸들러를 호출하지 않는다
+        void start();
+        void cancel();
+
+        // 리스닝 소켓은 그대로 두고 accept만 멈춘다 (같은 리스닝 소켓에 새 UringAcceptor를 시작해 이어서 받는다)
+        void stop();
+
+        virtual void complete(int result, uint32_t flags) override;
+
+    private:
+        void submit();
+        void onCompleted(int result, uint32_t flags);
+
+    private:
+        UringService& m_service;
+        int m_listenFd;
+        asio::any_io_executor m_executor;
+        AcceptHandler m_handler;
+        bool m_running = false;
+        bool m_submitted = false;
+    };
+}
+
+#endif // BYTEBORNE_HAS_IO_URING
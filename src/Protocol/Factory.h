@@ -25,7 +25,9 @@ namespace proto
         static inline std::unordered_map<MessageType, std::function<MessagePtr()>> s_factory =
         {
             { MessageType::S2C_Chat, []() { return std::make_shared<S2C_Chat>(); } },
-            { MessageType::C2S_Chat, []() { return std::make_shared<C2S_Chat>(); } }
+            { MessageType::S2C_Heartbeat, []() { return std::make_shared<S2C_Heartbeat>(); } },
+            { MessageType::C2S_Chat, []() { return std::make_shared<C2S_Chat>(); } },
+            { MessageType::C2S_Heartbeat, []() { return std::make_shared<C2S_Heartbeat>(); } }
         };
     };
 }
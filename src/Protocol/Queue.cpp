@@ -11,12 +11,12 @@ namespace proto
         // 메시지 큐 엔트리 생성
         MessageQueueEntry entry;
         entry.sessionId = sessionId;
-        entry.messageType = static_cast<MessageType>(packetView.header->id);
+        entry.messageType = static_cast<MessageType>(packetView.id);
         entry.message = MessageFactory::createMessage(entry.messageType);
 
         // 패킷의 페이로드를 메시지로 파싱
         const void* payload = packetView.payload;
-        const int payloadSize = packetView.header->size - sizeof(net::PacketHeader);
+        const int payloadSize = static_cast<int>(packetView.payloadSize);
         const bool parsingResult = entry.message->ParseFromArray(payload, payloadSize);
         assert(parsingResult);
 
@@ -0,0 +1,201 @@
+﻿#include "RateLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace proto
+{
+    void MessageRateLimiter::setSessionLimit(const RateLimit& limit)
+    {
+        assert(0.0 < limit.ratePerSecond);
+        assert(1.0 <= limit.burst);
+
+        m_hasSessionLimit = true;
+        m_sessionLimit = limit;
+    }
+
+    void MessageRateLimiter::setMessageLimit(MessageType messageType, const RateLimit& limit)
+    {
+        assert(0.0 < limit.ratePerSecond);
+        assert(1.0 <= limit.burst);
+        // 세션 상태가 생기기 전에 설정해야 버킷 배열 크기가 맞는다 (호출자가 가진 상태는 세션을 받기 전에 설정해 보장)
+        assert(m_sessions.empty());
+
+        auto it = m_messageLimitIndices.find(messageType);
+        if (it != m_messageLimitIndices.end())
+        {
+            m_messageLimits[it->second].limit = limit;
+            return;
+        }
+
+        m_messageLimitIndices[messageType] = m_messageLimits.size();
+        m_messageLimits.emplace_back(messageType, limit);
+    }
+
+    RateLimitDecision MessageRateLimiter::onPacket(
+        net::SessionId sessionId,
+        MessageType messageType,
+        Clock::time_point now,
+        std::chrono::milliseconds& retryAfter)
+    {
+        return onPacket(m_sessions[sessionId], messageType, now, retryAfter);
+    }
+
+    RateLimitDecision MessageRateLimiter::onPacket(
+        SessionState& state,
+        MessageType messageType,
+        Clock::time_point now,
+        std::chrono::milliseconds& retryAfter)
+    {
+        if (!state.initialized)
+        {
+            initializeSessionState(state, now);
+        }
+
+        TokenBucket* messageBucket = nullptr;
+        MessageLimit* messageLimit = nullptr;
+        auto it = m_messageLimitIndices.find(messageType);
+        if (it != m_messageLimitIndices.end())
+        {
+            messageBucket = &state.messageBuckets[it->second];
+            messageLimit = &m_messageLimits[it->second];
+        }
+
+        // 두 버킷 모두 토큰이 있을 때만 소비
+        double waitSeconds = 0.0;
+        RateLimitPolicy policy = RateLimitPolicy::Drop;
+
+        if (m_hasSessionLimit)
+        {
+            state.sessionBucket.refill(m_sessionLimit, now);
+            if (state.sessionBucket.tokens < 1.0)
+            {
+                waitSeconds = state.sessionBucket.getWaitSeconds(m_sessionLimit);
+                policy = m_sessionLimit.policy;
+            }
+        }
+
+        if (messageBucket)
+        {
+            messageBucket->refill(messageLimit->limit, now);
+            if ((messageBucket->tokens < 1.0) &&
+                (waitSeconds < messageBucket->getWaitSeconds(messageLimit->limit)))
+            {
+                // 더 오래 기다려야 하는 버킷의 정책을 따른다
+                waitSeconds = messageBucket->getWaitSeconds(messageLimit->limit);
+                policy = messageLimit->limit.policy;
+            }
+        }
+
+        AtomicCounters* messageCounters = messageLimit ? &messageLimit->counters : nullptr;
+        if (0.0 < waitSeconds)
+        {
+            retryAfter = std::chrono::milliseconds(static_cast<int64_t>(std::ceil(waitSeconds * 1000.0)));
+            return reject(policy, messageCounters);
+        }
+
+        if (m_hasSessionLimit)
+        {
+            state.sessionBucket.tokens -= 1.0;
+        }
+
+        if (messageBucket)
+        {
+            messageBucket->tokens -= 1.0;
+        }
+
+        m_counters.accepted.fetch_add(1, std::memory_order_relaxed);
+        if (messageCounters)
+        {
+            messageCounters->accepted.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return RateLimitDecision::Accept;
+    }
+
+    void MessageRateLimiter::removeSession(net::SessionId sessionId)
+    {
+        m_sessions.erase(sessionId);
+    }
+
+    std::optional<RateLimitCounters> MessageRateLimiter::findMessageCounters(MessageType messageType) const
+    {
+        auto it = m_messageLimitIndices.find(messageType);
+        if (it == m_messageLimitIndices.end())
+        {
+            return std::nullopt;
+        }
+
+        return m_messageLimits[it->second].counters.load();
+    }
+
+    RateLimitCounters MessageRateLimiter::AtomicCounters::load() const
+    {
+        RateLimitCounters counters;
+        counters.accepted = accepted.load(std::memory_order_relaxed);
+        counters.dropped = dropped.load(std::memory_order_relaxed);
+        counters.delayed = delayed.load(std::memory_order_relaxed);
+        counters.disconnected = disconnected.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+    void MessageRateLimiter::TokenBucket::refill(const RateLimit& limit, Clock::time_point now)
+    {
+        const double elapsedSeconds = std::chrono::duration<double>(now - lastRefill).count();
+        if (0.0 < elapsedSeconds)
+        {
+            tokens = std::min(limit.burst, tokens + (elapsedSeconds * limit.ratePerSecond));
+            lastRefill = now;
+        }
+    }
+
+    double MessageRateLimiter::TokenBucket::getWaitSeconds(const RateLimit& limit) const
+    {
+        return (1.0 - tokens) / limit.ratePerSecond;
+    }
+
+    void MessageRateLimiter::initializeSessionState(SessionState& state, Clock::time_point now) const
+    {
+        // 새 세션은 버킷이 가득 찬 상태로 시작
+        state.initialized = true;
+        state.sessionBucket.tokens = m_sessionLimit.burst;
+        state.sessionBucket.lastRefill = now;
+
+        state.messageBuckets.resize(m_messageLimits.size());
+        for (size_t i = 0; i < m_messageLimits.size(); ++i)
+        {
+            state.messageBuckets[i].tokens = m_messageLimits[i].limit.burst;
+            state.messageBuckets[i].lastRefill = now;
+        }
+    }
+
+    RateLimitDecision MessageRateLimiter::reject(RateLimitPolicy policy, AtomicCounters* messageCounters)
+    {
+        switch (policy)
+        {
+        case RateLimitPolicy::Drop:
+            m_counters.dropped.fetch_add(1, std::memory_order_relaxed);
+            if (messageCounters)
+            {
+                messageCounters->dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            return RateLimitDecision::Drop;
+        case RateLimitPolicy::Delay:
+            m_counters.delayed.fetch_add(1, std::memory_order_relaxed);
+            if (messageCounters)
+            {
+                messageCounters->delayed.fetch_add(1, std::memory_order_relaxed);
+            }
+            return RateLimitDecision::Delay;
+        case RateLimitPolicy::Disconnect:
+            m_counters.disconnected.fetch_add(1, std::memory_order_relaxed);
+            if (messageCounters)
+            {
+                messageCounters->disconnected.fetch_add(1, std::memory_order_relaxed);
+            }
+            return RateLimitDecision::Disconnect;
+        }
+
+        assert(false);
+        return RateLimitDecision::Drop;
+    }
+}
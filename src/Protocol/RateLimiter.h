@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Type.h"
+#include "Network/Session.h"
+
+namespace proto
+{
+    // 토큰이 부족할 때의 처리 방식
+    enum class RateLimitPolicy
+    {
+        Drop,       // 패킷을 파싱하지 않고 버림
+        Delay,      // 토큰이 찰 때까지 해당 세션의 수신 처리를 멈춤
+        Disconnect, // 세션 종료
+    };
+
+    enum class RateLimitDecision
+    {
+        Accept,
+        Drop,
+        Delay,
+        Disconnect,
+    };
+
+    struct RateLimit
+    {
+        double ratePerSecond = 0.0; // 초당 충전되는 토큰 수
+        double burst = 0.0;         // 버킷 최대 토큰 수
+        RateLimitPolicy policy = RateLimitPolicy::Drop;
+    };
+
+    struct RateLimitCounters
+    {
+        uint64_t accepted = 0;
+        uint64_t dropped = 0;
+        uint64_t delayed = 0;
+        uint64_t disconnected = 0;
+    };
+
+    // 세션 전체 및 메시지 타입별 토큰 버킷으로 수신 패킷을 파싱 전에 제한
+    // 제한은 세션을 받기 전에 메인 스레드에서 설정하고, 그 뒤로는 세션마다 하나의 스레드에서 onPacket()을 호출한다
+    // (세션 ID로 찾는 상태는 메인 스레드에서만, 호출자가 가진 SessionState는 그 세션을 처리하는 스레드에서만 사용)
+    class MessageRateLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct TokenBucket
+        {
+            double tokens = 0.0;
+            Clock::time_point lastRefill;
+
+            void refill(const RateLimit& limit, Clock::time_point now);
+            double getWaitSeconds(const RateLimit& limit) const;
+        };
+
+        // 세션 하나의 버킷 (첫 패킷에서 가득 찬 상태로 초기화)
+        struct SessionState
+        {
+            bool initialized = false;
+            TokenBucket sessionBucket;
+            std::vector<TokenBucket> messageBuckets; // m_messageLimits와 같은 순서
+        };
+
+    public:
+        // 세션의 모든 메시지에 적용되는 제한
+        void setSessionLimit(const RateLimit& limit);
+
+        // 특정 메시지 타입에 추가로 적용되는 제한
+        void setMessageLimit(MessageType messageType, const RateLimit& limit);
+
+        // 패킷 하나에 대한 처리 결정
+        // Delay인 경우 retryAfter에 다시 시도할 때까지의 대기 시간을 기록
+        RateLimitDecision onPacket(
+            net::SessionId sessionId,
+            MessageType messageType,
+            Clock::time_point now,
+            std::chrono::milliseconds& retryAfter);
+
+        // 호출자가 가진 세션 상태로 결정 (여러 IO 스레드에서 각자의 세션 상태로 동시에 호출 가능)
+        RateLimitDecision onPacket(
+            SessionState& state,
+            MessageType messageType,
+            Clock::time_point now,
+            std::chrono::milliseconds& retryAfter);
+
+        void removeSession(net::SessionId sessionId);
+
+        // 통계 (어느 스레드에서든 읽을 수 있음)
+        RateLimitCounters getCounters() const { return m_counters.load(); }
+        std::optional<RateLimitCounters> findMessageCounters(MessageType messageType) const;
+
+    private:
+        struct AtomicCounters
+        {
+            std::atomic<uint64_t> accepted = 0;
+            std::atomic<uint64_t> dropped = 0;
+            std::atomic<uint64_t> delayed = 0;
+            std::atomic<uint64_t> disconnected = 0;
+
+            RateLimitCounters load() const;
+        };
+
+        struct MessageLimit
+        {
+            MessageLimit(MessageType messageType, const RateLimit& limit) : messageType(messageType), limit(limit) {}
+
+            MessageType messageType;
+            RateLimit limit;
+            AtomicCounters counters;
+        };
+
+        void initializeSessionState(SessionState& state, Clock::time_point now) const;
+        RateLimitDecision reject(RateLimitPolicy policy, AtomicCounters* messageCounters);
+
+    private:
+        bool m_hasSessionLimit = false;
+        RateLimit m_sessionLimit;
+        std::deque<MessageLimit> m_messageLimits; // 이동할 수 없는 원자적 통계를 담고 있어 deque에 보관
+        std::unordered_map<MessageType, size_t> m_messageLimitIndices;
+        std::unordered_map<net::SessionId, SessionState> m_sessions;
+        AtomicCounters m_counters;
+    };
+}
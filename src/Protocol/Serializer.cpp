@@ -0,0 +1,205 @@
+﻿#include "Serializer.h"
+#include "Network/Compression.h"
+#include <algorithm>
+#include <cstring>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+
+namespace proto
+{
+    namespace
+    {
+        // 직렬화 출력이 조각 경계에 닿을 때마다 다음 조각 패킷의 헤더를 써 넣는 출력 스트림
+        // 메시지는 중간 버퍼 없이 송신 버퍼의 조각 데이터 영역에 바로 직렬화된다
+        class FragmentOutputStream
+            : public google::protobuf::io::ZeroCopyOutputStream
+        {
+        public:
+            FragmentOutputStream(uint8_t* buffer, net::PacketId id, size_t messageSize)
+                : m_writePtr(buffer)
+                , m_id(id)
+                , m_messageSize(messageSize)
+            {}
+
+            bool Next(void** data, int* size) override
+            {
+                if (m_messageSize <= m_byteCount)
+                {
+                    return false;
+                }
+
+                const size_t remainingSize = m_messageSize - m_byteCount;
+
+                m_currentHeader = reinterpret_cast<net::PacketHeader*>(m_writePtr);
+                m_writePtr += sizeof(net::PacketHeader);
+
+                size_t dataSize = 0;
+                if (m_byteCount == 0)
+                {
+                    net::FragmentHeader* fragmentHeader = reinterpret_cast<net::FragmentHeader*>(m_writePtr);
+                    fragmentHeader->messageSize = static_cast<uint32_t>(m_messageSize);
+                    fragmentHeader->id = m_id;
+                    m_writePtr += sizeof(net::FragmentHeader);
+
+                    m_currentHeader->id = net::FragmentBeginPacketId;
+                    dataSize = std::min(remainingSize, net::FirstFragmentDataSize);
+                }
+                else
+                {
+                    m_currentHeader->id = net::FragmentPacketId;
+                    dataSize = std::min(remainingSize, net::FragmentDataSize);
+                }
+
+                m_currentHeader->size = static_cast<net::PacketSize>(
+                    (m_writePtr - reinterpret_cast<uint8_t*>(m_currentHeader)) + dataSize);
+
+                *data = m_writePtr;
+                *size = static_cast<int>(dataSize);
+
+                m_writePtr += dataSize;
+                m_byteCount += dataSize;
+
+                return true;
+            }
+
+            void BackUp(int count) override
+            {
+                assert(m_currentHeader);
+                assert(static_cast<size_t>(count) <= m_currentHeader->size);
+
+                m_writePtr -= count;
+                m_byteCount -= count;
+                m_currentHeader->size = static_cast<net::PacketSize>(m_currentHeader->size - count);
+            }
+
+            int64_t ByteCount() const override { return static_cast<int64_t>(m_byteCount); }
+
+            size_t getWrittenSize(const uint8_t* buffer) const { return m_writePtr - buffer; }
+
+        private:
+            uint8_t* m_writePtr = nullptr;
+            net::PacketHeader* m_currentHeader = nullptr;
+            net::PacketId m_id = 0;
+            size_t m_messageSize = 0;
+            size_t m_byteCount = 0;
+        };
+
+        // 조각 패킷으로 나눴을 때 전체 크기
+        size_t getFragmentedSize(size_t messageSize)
+        {
+            // 첫 조각 이후 필요한 조각 수
+            const size_t nextFragmentCount =
+                (messageSize - net::FirstFragmentDataSize + net::FragmentDataSize - 1) / net::FragmentDataSize;
+
+            return messageSize +
+                sizeof(net::FragmentHeader) +
+                sizeof(net::PacketHeader) * (1 + nextFragmentCount);
+        }
+    }
+
+    void MessageSerializer::setCompressionPolicy(MessageType messageType, const CompressionPolicy& policy)
+    {
+        m_compressionPolicies[messageType] = policy;
+    }
+
+    net::SendBufferChunkPtr MessageSerializer::serializeFragments(const Message& message, net::PacketId id, size_t messageSize)
+    {
+        assert(net::FirstFragmentDataSize < messageSize);
+        assert(messageSize <= net::MaxMessageSize);
+
+        const size_t totalSize = getFragmentedSize(messageSize);
+
+        // 모든 조각을 하나의 청크에 연속으로 담아 다른 송신과 섞이지 않게 한다
+        net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+        uint8_t* buffer = chunk->getWritePtr();
+
+        FragmentOutputStream stream(buffer, id, messageSize);
+        {
+            google::protobuf::io::CodedOutputStream codedStream(&stream);
+            message.SerializeWithCachedSizes(&codedStream);
+        }
+
+        assert(static_cast<size_t>(stream.ByteCount()) == messageSize);
+        assert(stream.getWrittenSize(buffer) == totalSize);
+
+        // 쓰기 완료 처리
+        chunk->onWritten(totalSize);
+        chunk->close();
+
+        return chunk;
+    }
+
+    net::SendBufferChunkPtr MessageSerializer::serializeCompressed(
+        const Message& message, net::PacketId id, size_t messageSize, net::CompressionCodec codec)
+    {
+        assert(messageSize <= net::MaxMessageSize);
+
+        // 직렬화 결과와 압축 결과를 담을 임시 버퍼도 송신 버퍼 풀에서 빌린다
+        const size_t compressBound = net::PacketCompressor::getCompressBound(codec, messageSize);
+        net::SendBufferBlock* messageBlock = net::SendBufferPool::getLocal().acquire(messageSize);
+        net::SendBufferBlock* compressBlock = net::SendBufferPool::getLocal().acquire(sizeof(net::CompressionHeader) + compressBound);
+
+        message.SerializeWithCachedSizesToArray(messageBlock->getData());
+
+        uint8_t* payload = compressBlock->getData();
+        const size_t compressedSize = net::PacketCompressor::compress(
+            codec, messageBlock->getData(), messageSize, payload + sizeof(net::CompressionHeader), compressBound);
+        const size_t payloadSize = sizeof(net::CompressionHeader) + compressedSize;
+
+        net::SendBufferChunkPtr chunk;
+        if ((compressedSize != 0) && (payloadSize < messageSize))
+        {
+            net::CompressionHeader* header = reinterpret_cast<net::CompressionHeader*>(payload);
+            header->originalSize = static_cast<uint32_t>(messageSize);
+            header->id = id;
+            header->codec = codec;
+
+            chunk = writePayload(net::CompressedPacketId, payload, payloadSize);
+        }
+
+        net::SendBufferPool::release(compressBlock);
+        net::SendBufferPool::release(messageBlock);
+
+        return chunk;
+    }
+
+    net::SendBufferChunkPtr MessageSerializer::writePayload(net::PacketId id, const uint8_t* payload, size_t payloadSize)
+    {
+        if (payloadSize <= net::MaxPacketSize - sizeof(net::PacketHeader))
+        {
+            const size_t totalSize = sizeof(net::PacketHeader) + payloadSize;
+            net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+            net::PacketHeader* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+            header->size = static_cast<net::PacketSize>(totalSize);
+            header->id = id;
+            std::memcpy(header + 1, payload, payloadSize);
+
+            chunk->onWritten(totalSize);
+            chunk->close();
+
+            return chunk;
+        }
+
+        const size_t totalSize = getFragmentedSize(payloadSize);
+        net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+        uint8_t* buffer = chunk->getWritePtr();
+
+        // 조각 경계는 직렬화할 때와 같은 출력 스트림으로 나눈다
+        FragmentOutputStream stream(buffer, id, payloadSize);
+        void* data = nullptr;
+        int size = 0;
+        while (stream.Next(&data, &size))
+        {
+            std::memcpy(data, payload + (stream.ByteCount() - size), size);
+        }
+
+        assert(static_cast<size_t>(stream.ByteCount()) == payloadSize);
+        assert(stream.getWrittenSize(buffer) == totalSize);
+
+        chunk->onWritten(totalSize);
+        chunk->close();
+
+        return chunk;
+    }
+}
@@ -4,17 +4,40 @@
 #include "Network/Buffer.h"
 #include "Network/Packet.h"
 #include <type_traits>
+#include <unordered_map>
 
 namespace proto
 {
+    enum class CompressionMode
+    {
+        Never,      // 압축하지 않음
+        AboveSize,  // 직렬화 크기가 minSize 이상일 때만 압축
+        Always,
+    };
+
+    struct CompressionPolicy
+    {
+        CompressionMode mode = CompressionMode::Never;
+        size_t minSize = 0;
+        net::CompressionCodec codec = net::CompressionCodec::Lz4;
+
+        bool shouldCompress(size_t messageSize) const
+        {
+            return (mode == CompressionMode::Always) ||
+                   ((mode == CompressionMode::AboveSize) && (minSize <= messageSize));
+        }
+    };
+
+    // 호출한 스레드의 SendBufferManager를 사용하므로 어느 스레드에서든 잠금 없이 직렬화할 수 있다
     class MessageSerializer
     {
     public:
-        MessageSerializer(net::SendBufferManager& sendBufferManager)
-            : m_sendBufferManager(sendBufferManager)
-        {}
+        // 메시지 타입별 압축 정책 (직렬화를 시작하기 전에 설정, 설정하지 않은 타입은 압축하지 않음)
+        void setCompressionPolicy(MessageType messageType, const CompressionPolicy& policy);
 
         // 메시지를 패킷 형태로 SendBuffer에 직렬화하는 템플릿 함수
+        // net::MaxPacketSize를 넘는 메시지는 하나의 청크 안에 연속된 조각 패킷으로 직렬화한다
+        // 압축 정책에 해당하면 압축한 페이로드를 net::CompressedPacketId 패킷으로 직렬화한다
         template<typename TMessage>
         net::SendBufferChunkPtr serializeToSendBuffer(const TMessage& message)
         {
@@ -25,8 +48,25 @@ namespace proto
             size_t messageSize = message.ByteSizeLong();
             size_t totalSize = sizeof(net::PacketHeader) + messageSize;
 
+            const CompressionPolicy* policy = findCompressionPolicy(MessageTypeTraits<TMessage>::Value);
+            if (policy && policy->shouldCompress(messageSize))
+            {
+                // 압축해도 작아지지 않으면 그대로 직렬화
+                net::SendBufferChunkPtr chunk = serializeCompressed(
+                    message, static_cast<net::PacketId>(MessageTypeTraits<TMessage>::Value), messageSize, policy->codec);
+                if (chunk)
+                {
+                    return chunk;
+                }
+            }
+
+            if (net::MaxPacketSize < totalSize)
+            {
+                return serializeFragments(message, static_cast<net::PacketId>(MessageTypeTraits<TMessage>::Value), messageSize);
+            }
+
             // 전송 버퍼 열기
-            net::SendBufferChunkPtr chunk = m_sendBufferManager.open(totalSize);
+            net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
 
             // 패킷 헤더 작성
             net::PacketHeader* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
@@ -44,6 +84,28 @@ namespace proto
         }
 
     private:
-        net::SendBufferManager& m_sendBufferManager;
+        const CompressionPolicy* findCompressionPolicy(MessageType messageType) const
+        {
+            if (m_compressionPolicies.empty())
+            {
+                return nullptr;
+            }
+
+            auto it = m_compressionPolicies.find(messageType);
+            return (it != m_compressionPolicies.end()) ? &it->second : nullptr;
+        }
+
+        // ByteSizeLong()으로 크기가 계산된 메시지를 조각 패킷으로 직렬화
+        static net::SendBufferChunkPtr serializeFragments(const Message& message, net::PacketId id, size_t messageSize);
+
+        // ByteSizeLong()으로 크기가 계산된 메시지를 압축 패킷으로 직렬화 (압축 효과가 없으면 nullptr)
+        static net::SendBufferChunkPtr serializeCompressed(
+            const Message& message, net::PacketId id, size_t messageSize, net::CompressionCodec codec);
+
+        // 이미 만들어진 페이로드를 패킷 하나 또는 조각 패킷으로 복사
+        static net::SendBufferChunkPtr writePayload(net::PacketId id, const uint8_t* payload, size_t payloadSize);
+
+    private:
+        std::unordered_map<MessageType, CompressionPolicy> m_compressionPolicies;
     };
 }
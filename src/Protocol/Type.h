@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Chat.pb.h"
+#include "Heartbeat.pb.h"
 #include "Network/Packet.h"
 
 namespace proto
@@ -12,7 +13,9 @@ namespace proto
     {
         None = 0,
         S2C_Chat = 1000,
+        S2C_Heartbeat = 1001,
         C2S_Chat = 2000,
+        C2S_Heartbeat = 2001,
     };
 
     template<typename T>
@@ -33,5 +36,17 @@ namespace proto
         static constexpr MessageType Value = MessageType::C2S_Chat;
     };
 
+    template<>
+    struct MessageTypeTraits<S2C_Heartbeat>
+    {
+        static constexpr MessageType Value = MessageType::S2C_Heartbeat;
+    };
+
+    template<>
+    struct MessageTypeTraits<C2S_Heartbeat>
+    {
+        static constexpr MessageType Value = MessageType::C2S_Heartbeat;
+    };
+
     ////////////////////////////////////////////////////////////////////////////////////////
 }
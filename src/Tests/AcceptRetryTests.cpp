@@ -0,0 +1,117 @@
+﻿#include "Test.h"
+#include "Network/Service.h"
+#include "Network/Event.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint16_t TestPort = 12351;
+
+    // 디스크립터 한도를 낮춰 수락이 EMFILE로 실패하게 한 뒤, 한도를 되돌리면 리슨 큐에 남은 연결을 수락하는지 확인
+    void checkAcceptRetry(net::TransportBackend backend)
+    {
+        net::IoThreadPool ioThreadPool(1);
+        net::ServiceEventQueue serviceEventQueue;
+        net::SessionEventQueue sessionEventQueue;
+
+        auto service = net::ServerService::createInstance(
+            ioThreadPool, serviceEventQueue, TestPort,
+            [&ioThreadPool, &sessionEventQueue](net::SessionTransportPtr&& transport)
+            {
+                return net::Session::createInstance(std::move(transport), sessionEventQueue, ioThreadPool.getThreadModel());
+            });
+        service->setTransportBackend(backend);
+
+        ioThreadPool.run();
+        service->start();
+
+        // 클라이언트 소켓은 한도를 낮추기 전에 연다
+        asio::io_context clientContext;
+        asio::ip::tcp::socket client(clientContext);
+        client.open(asio::ip::tcp::v4());
+
+        rlimit originalLimit{};
+        ::getrlimit(RLIMIT_NOFILE, &originalLimit);
+
+        // 다음에 열릴 디스크립터 번호를 한도로 두면 새 디스크립터를 만들 수 없다
+        const int nextFd = ::open("/dev/null", O_RDONLY);
+        ::close(nextFd);
+
+        rlimit loweredLimit = originalLimit;
+        loweredLimit.rlim_cur = static_cast<rlim_t>(nextFd);
+        ::setrlimit(RLIMIT_NOFILE, &loweredLimit);
+
+        asio::error_code error;
+        client.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), TestPort), error);
+        CHECK(!error);
+
+        // 수락은 실패하고 연결은 리슨 큐에 남는다
+        std::this_thread::sleep_for(50ms);
+        net::ServiceEventPtr event;
+        const bool acceptedWhileExhausted = serviceEventQueue.pop(event);
+
+        ::setrlimit(RLIMIT_NOFILE, &originalLimit);
+
+        CHECK(!acceptedWhileExhausted);
+
+        // acceptor가 멈추지 않고 대기가 끝나면 다시 수락한다
+        CHECK(test::waitUntil([&serviceEventQueue, &event]() { return serviceEventQueue.pop(event); }, 2s));
+        if (event && (event->type == net::ServiceEventType::Accept))
+        {
+            net::SessionPtr session = static_cast<net::ServiceAcceptEvent*>(event.get())->session;
+            session->start();
+            session->stop();
+
+            CHECK(test::waitUntil(
+                [&sessionEventQueue]()
+                {
+                    net::SessionEventPtr sessionEvent;
+                    while (sessionEventQueue.pop(sessionEvent))
+                    {
+                        if (sessionEvent->type == net::SessionEventType::Close)
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }, 1s));
+        }
+        else
+        {
+            CHECK(false);
+        }
+
+        service->stop();
+
+        // 서비스가 닫히기 전에 IO 스레드를 멈추면 리스닝 소켓이 남아 다음 테스트가 같은 포트에 바인딩하지 못한다
+        test::waitUntil(
+            [&serviceEventQueue]()
+            {
+                net::ServiceEventPtr serviceEvent;
+                while (serviceEventQueue.pop(serviceEvent))
+                {
+                    if (serviceEvent->type == net::ServiceEventType::Close)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }, 1s);
+
+        ioThreadPool.stop();
+        ioThreadPool.join();
+    }
+}
+
+// io_uring의 accept는 제출할 때의 한도를 쓰므로, 걸어 둔 multishot accept는 한도를 낮춰도 실패하지 않아 socket 백엔드로만 확인한다
+TEST_CASE(AcceptRetry_ResumesAfterDescriptorExhaustion)
+{
+    checkAcceptRetry(net::TransportBackend::Socket);
+}
+#endif // __linux__
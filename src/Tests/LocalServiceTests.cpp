@@ -0,0 +1,83 @@
+﻿#include "Test.h"
+#include "Network/Service.h"
+#include <filesystem>
+#include <fstream>
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+namespace
+{
+    const std::string TestSocketPath = (std::filesystem::temp_directory_path() / "byteborne-world-test.sock").string();
+
+    // 소켓 파일 자리에 서비스를 만들고 바인딩에 성공했는지 반환
+    bool createLocalService(const std::string& path)
+    {
+        net::IoThreadPool ioThreadPool(1);
+        net::ServiceEventQueue eventQueue;
+
+        try
+        {
+            auto service = std::make_shared<net::ServerService>(
+                ioThreadPool, eventQueue, path,
+                [](net::SessionTransportPtr&&)
+                {
+                    return net::SessionPtr();
+                });
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::info("[Test] 로컬 서비스 생성 실패: {}", error.what());
+            return false;
+        }
+
+        return true;
+    }
+}
+
+// 연결을 받는 프로세스가 없는 소켓 파일은 지우고 바인딩한다
+TEST_CASE(LocalService_RemovesStaleSocketFile)
+{
+    std::filesystem::remove(TestSocketPath);
+
+    {
+        // 닫아도 소켓 파일은 남는다 (비정상 종료한 이전 프로세스)
+        asio::io_context ioContext;
+        asio::local::stream_protocol::acceptor acceptor(ioContext, asio::local::stream_protocol::endpoint(TestSocketPath));
+    }
+    CHECK(std::filesystem::exists(TestSocketPath));
+
+    CHECK(createLocalService(TestSocketPath));
+
+    std::filesystem::remove(TestSocketPath);
+}
+
+// 다른 프로세스가 연결을 받고 있는 소켓 파일은 지우지 않는다
+TEST_CASE(LocalService_KeepsLiveSocketFile)
+{
+    std::filesystem::remove(TestSocketPath);
+
+    asio::io_context ioContext;
+    asio::local::stream_protocol::acceptor acceptor(ioContext, asio::local::stream_protocol::endpoint(TestSocketPath));
+
+    CHECK(!createLocalService(TestSocketPath));
+
+    // 기존 acceptor는 계속 연결을 받는다
+    asio::local::stream_protocol::socket client(ioContext);
+    asio::error_code error;
+    client.connect(asio::local::stream_protocol::endpoint(TestSocketPath), error);
+    CHECK(!error);
+
+    std::filesystem::remove(TestSocketPath);
+}
+
+// 소켓이 아닌 파일은 지우지 않는다
+TEST_CASE(LocalService_KeepsRegularFile)
+{
+    std::filesystem::remove(TestSocketPath);
+    std::ofstream(TestSocketPath) << "not a socket";
+
+    CHECK(!createLocalService(TestSocketPath));
+    CHECK(std::filesystem::is_regular_file(TestSocketPath));
+
+    std::filesystem::remove(TestSocketPath);
+}
+#endif // ASIO_HAS_LOCAL_SOCKETS
@@ -0,0 +1,97 @@
+﻿#include "LoopbackSessionFixture.h"
+#include "Test.h"
+#include "Network/Event.h"
+
+namespace test
+{
+    using namespace std::chrono_literals;
+
+    LoopbackSessionFixture::LoopbackSessionFixture(size_t pipeCapacity, const Configure& configure)
+        : m_workGuard(asio::make_work_guard(m_ioContext))
+        , m_inbound(std::make_shared<net::LoopbackPipe>(pipeCapacity))
+        , m_outbound(std::make_shared<net::LoopbackPipe>(pipeCapacity))
+    {
+        m_session = net::Session::createInstance(
+            std::make_unique<net::LoopbackTransport>(m_ioContext, m_inbound, m_outbound),
+            m_eventQueue);
+
+        if (configure)
+        {
+            configure(m_session);
+        }
+
+        m_session->start();
+
+        m_ioThread = std::thread(
+            [this]()
+            {
+                m_ioContext.run();
+            });
+    }
+
+    LoopbackSessionFixture::~LoopbackSessionFixture()
+    {
+        m_session->stop();
+        waitUntil([this]() { return isClosed(); }, 1s);
+
+        m_workGuard.reset();
+        m_ioContext.stop();
+        m_ioThread.join();
+    }
+
+    void LoopbackSessionFixture::write(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        size_t written = 0;
+        while ((written < size) && !m_inbound->isClosed())
+        {
+            written += m_inbound->write(bytes + written, size - written);
+            if (written < size)
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+        }
+    }
+
+    void LoopbackSessionFixture::processReceive(const PacketHandler& onPacket)
+    {
+        net::SessionEventPtr event;
+        while (m_eventQueue.pop(event))
+        {
+            if (event->type == net::SessionEventType::Close)
+            {
+                m_closed = true;
+                continue;
+            }
+
+            if ((event->type != net::SessionEventType::Receive) || !m_session->isRunning())
+            {
+                continue;
+            }
+
+            net::PacketView packet;
+            while (m_session->getFrontPacket(packet))
+            {
+                onPacket(packet);
+                m_session->popFrontPacket();
+            }
+
+            m_session->receive();
+        }
+    }
+
+    bool LoopbackSessionFixture::isClosed()
+    {
+        net::SessionEventPtr event;
+        while (m_eventQueue.pop(event))
+        {
+            if (event->type == net::SessionEventType::Close)
+            {
+                m_closed = true;
+            }
+        }
+
+        return m_closed;
+    }
+}
@@ -0,0 +1,51 @@
+﻿#pragma once
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include "Network/Session.h"
+#include "Network/Loopback.h"
+
+namespace test
+{
+    // LoopbackPipe 한 쌍에 연결된 세션과 그 세션을 실행하는 IO 스레드
+    // 테스트 스레드는 inbound 파이프에 직접 써서 세션에 데이터를 보내고, outbound 파이프는 읽지 않으면 세션의 송신이 그대로 쌓인다
+    class LoopbackSessionFixture
+    {
+    public:
+        // 세션을 시작하기 전에 호출 (송신 큐 설정, 세션 관리자 등록 등)
+        using Configure = std::function<void(const net::SessionPtr&)>;
+
+        // 세션이 받은 패킷 하나를 넘겨받는다
+        using PacketHandler = std::function<void(const net::PacketView&)>;
+
+    public:
+        explicit LoopbackSessionFixture(size_t pipeCapacity, const Configure& configure = nullptr);
+        ~LoopbackSessionFixture();
+
+        LoopbackSessionFixture(const LoopbackSessionFixture&) = delete;
+        LoopbackSessionFixture& operator=(const LoopbackSessionFixture&) = delete;
+
+        const net::SessionPtr& getSession() const { return m_session; }
+        net::LoopbackPipe& getInbound() { return *m_inbound; }
+
+        // 파이프가 받을 수 있을 때마다 나눠 써서 모두 쓰거나 파이프가 닫힐 때까지 대기
+        void write(const void* data, size_t size);
+
+        // WorldServer의 메인 스레드처럼 수신 이벤트마다 받은 패킷을 onPacket에 넘기고 다음 수신을 시작
+        void processReceive(const PacketHandler& onPacket);
+
+        // 세션의 Close 이벤트를 받았는지 (다른 이벤트는 버린다)
+        bool isClosed();
+
+    private:
+        asio::io_context m_ioContext;
+        asio::executor_work_guard<asio::io_context::executor_type> m_workGuard;
+        std::shared_ptr<net::LoopbackPipe> m_inbound;
+        std::shared_ptr<net::LoopbackPipe> m_outbound;
+        net::SessionEventQueue m_eventQueue;
+        net::SessionPtr m_session;
+        std::thread m_ioThread;
+        bool m_closed = false;
+    };
+}
@@ -0,0 +1,68 @@
+﻿#include "Core/Context.h"
+#include "Test.h"
+#include <cstring>
+
+namespace test
+{
+    namespace
+    {
+        std::atomic<size_t> s_failureCount = 0;
+    }
+
+    std::vector<TestCase>& getTestCases()
+    {
+        static std::vector<TestCase> s_testCases;
+        return s_testCases;
+    }
+
+    void fail(const char* file, int line, const char* expression)
+    {
+        s_failureCount.fetch_add(1);
+        spdlog::error("[Test] 실패: {}:{} CHECK({})", file, line, expression);
+    }
+
+    size_t getFailureCount()
+    {
+        return s_failureCount.load();
+    }
+}
+
+// 인자가 없으면 모든 테스트를, 있으면 이름에 인자를 포함하는 테스트만 실행
+int main(int argc, char* argv[])
+{
+    core::AppContext::getInstance().initialize();
+
+    const char* filter = (1 < argc) ? argv[1] : nullptr;
+    size_t runCount = 0;
+    size_t failedCount = 0;
+
+    for (const test::TestCase& testCase : test::getTestCases())
+    {
+        if (filter && (std::strstr(testCase.name, filter) == nullptr))
+        {
+            continue;
+        }
+
+        const size_t failureCountBefore = test::getFailureCount();
+        const auto startTime = std::chrono::steady_clock::now();
+
+        testCase.function();
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        const bool passed = (test::getFailureCount() == failureCountBefore);
+
+        ++runCount;
+        if (!passed)
+        {
+            ++failedCount;
+        }
+
+        spdlog::info("[Test] {} {} ({}ms)", passed ? "PASS" : "FAIL", testCase.name, elapsed.count());
+    }
+
+    spdlog::info("[Test] {}개 중 {}개 실패", runCount, failedCount);
+
+    core::AppContext::getInstance().cleanup();
+
+    return ((failedCount == 0) && (0 < runCount)) ? 0 : 1;
+}
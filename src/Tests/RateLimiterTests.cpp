@@ -0,0 +1,125 @@
+﻿#include "Test.h"
+#include "Protocol/RateLimiter.h"
+
+namespace
+{
+    using namespace std::chrono_literals;
+    using Clock = proto::MessageRateLimiter::Clock;
+
+    constexpr net::SessionId TestSessionId = 1;
+
+    proto::RateLimitDecision onPacket(proto::MessageRateLimiter& rateLimiter, proto::MessageType type, Clock::time_point now)
+    {
+        std::chrono::milliseconds retryAfter(0);
+        return rateLimiter.onPacket(TestSessionId, type, now, retryAfter);
+    }
+}
+
+// 버킷은 가득 찬 상태로 시작하고, 경과 시간만큼 초당 비율로 다시 차며 burst를 넘지 않는다
+TEST_CASE(RateLimiter_TokenBucketRefillsAtRate)
+{
+    proto::MessageRateLimiter rateLimiter;
+    rateLimiter.setSessionLimit({ 10.0, 5.0, proto::RateLimitPolicy::Drop });
+
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < 5; ++i)
+    {
+        CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Accept);
+    }
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Drop);
+
+    // 100ms에 토큰 하나
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start + 100ms) == proto::RateLimitDecision::Accept);
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start + 100ms) == proto::RateLimitDecision::Drop);
+
+    // 오래 쉬어도 burst만큼만 찬다
+    const Clock::time_point later = start + 10s;
+    for (int i = 0; i < 5; ++i)
+    {
+        CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, later) == proto::RateLimitDecision::Accept);
+    }
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, later) == proto::RateLimitDecision::Drop);
+
+    const proto::RateLimitCounters counters = rateLimiter.getCounters();
+    CHECK(counters.accepted == 11);
+    CHECK(counters.dropped == 3);
+}
+
+// Delay는 토큰 하나가 찰 때까지의 시간을 알려 준다
+TEST_CASE(RateLimiter_DelayReportsRetryAfter)
+{
+    proto::MessageRateLimiter rateLimiter;
+    rateLimiter.setSessionLimit({ 10.0, 1.0, proto::RateLimitPolicy::Delay });
+
+    const Clock::time_point start = Clock::now();
+    std::chrono::milliseconds retryAfter(0);
+    CHECK(rateLimiter.onPacket(TestSessionId, proto::MessageType::S2C_Chat, start, retryAfter) == proto::RateLimitDecision::Accept);
+
+    CHECK(rateLimiter.onPacket(TestSessionId, proto::MessageType::S2C_Chat, start, retryAfter) == proto::RateLimitDecision::Delay);
+    CHECK(retryAfter == 100ms);
+
+    CHECK(rateLimiter.onPacket(TestSessionId, proto::MessageType::S2C_Chat, start + 40ms, retryAfter) == proto::RateLimitDecision::Delay);
+    CHECK(retryAfter == 60ms);
+
+    // 지연된 패킷은 토큰을 쓰지 않으므로 알려 준 시간 뒤에 받아들여진다
+    CHECK(rateLimiter.onPacket(TestSessionId, proto::MessageType::S2C_Chat, start + 100ms, retryAfter) == proto::RateLimitDecision::Accept);
+    CHECK(rateLimiter.getCounters().delayed == 2);
+}
+
+// 타입별 제한은 그 타입에만 적용되고, 더 오래 기다려야 하는 버킷의 정책을 따른다
+TEST_CASE(RateLimiter_MessageLimitPolicies)
+{
+    proto::MessageRateLimiter rateLimiter;
+    rateLimiter.setSessionLimit({ 100.0, 3.0, proto::RateLimitPolicy::Delay });
+    rateLimiter.setMessageLimit(proto::MessageType::C2S_Chat, { 1.0, 1.0, proto::RateLimitPolicy::Disconnect });
+
+    const Clock::time_point start = Clock::now();
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Accept);
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Disconnect);
+    CHECK(onPacket(rateLimiter, proto::MessageType::S2C_Chat, start) == proto::RateLimitDecision::Accept);
+    CHECK(onPacket(rateLimiter, proto::MessageType::S2C_Chat, start) == proto::RateLimitDecision::Accept);
+
+    // 세션 버킷이 비어도 채팅 버킷이 더 오래 기다려야 하므로 채팅 정책을 따른다
+    CHECK(onPacket(rateLimiter, proto::MessageType::S2C_Chat, start) == proto::RateLimitDecision::Delay);
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Disconnect);
+
+    const std::optional<proto::RateLimitCounters> chatCounters = rateLimiter.findMessageCounters(proto::MessageType::C2S_Chat);
+    CHECK(chatCounters.has_value());
+    if (chatCounters)
+    {
+        CHECK(chatCounters->accepted == 1);
+        CHECK(chatCounters->disconnected == 2);
+    }
+    CHECK(!rateLimiter.findMessageCounters(proto::MessageType::S2C_Chat));
+
+    const proto::RateLimitCounters counters = rateLimiter.getCounters();
+    CHECK(counters.accepted == 3);
+    CHECK(counters.delayed == 1);
+    CHECK(counters.disconnected == 2);
+}
+
+// 호출자가 가진 세션 상태는 세션 ID로 찾는 상태와 따로 센다
+TEST_CASE(RateLimiter_CallerOwnedSessionState)
+{
+    proto::MessageRateLimiter rateLimiter;
+    rateLimiter.setMessageLimit(proto::MessageType::C2S_Chat, { 1.0, 2.0, proto::RateLimitPolicy::Drop });
+
+    const Clock::time_point start = Clock::now();
+    std::chrono::milliseconds retryAfter(0);
+
+    proto::MessageRateLimiter::SessionState first;
+    proto::MessageRateLimiter::SessionState second;
+    for (int i = 0; i < 2; ++i)
+    {
+        CHECK(rateLimiter.onPacket(first, proto::MessageType::C2S_Chat, start, retryAfter) == proto::RateLimitDecision::Accept);
+        CHECK(rateLimiter.onPacket(second, proto::MessageType::C2S_Chat, start, retryAfter) == proto::RateLimitDecision::Accept);
+    }
+    CHECK(rateLimiter.onPacket(first, proto::MessageType::C2S_Chat, start, retryAfter) == proto::RateLimitDecision::Drop);
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Accept);
+
+    // 세션을 제거하면 다음 패킷은 가득 찬 버킷으로 시작한다
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Accept);
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Drop);
+    rateLimiter.removeSession(TestSessionId);
+    CHECK(onPacket(rateLimiter, proto::MessageType::C2S_Chat, start) == proto::RateLimitDecision::Accept);
+}
@@ -0,0 +1,231 @@
+﻿#include "Test.h"
+#include "LoopbackSessionFixture.h"
+#include "Network/Packet.h"
+#include "Network/Compression.h"
+#include <cstring>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    // 세션은 테스트 스레드가 수신 이벤트를 처리해야 다음 읽기를 시작하므로, 쓰는 동안 막히지 않게 보내는 메시지 전체가 들어가는 크기
+    constexpr size_t PipeCapacity = 256 * 1024;
+
+    // 테스트 스레드가 파이프에 패킷을 직접 써서 세션에 보내는 상대
+    // 세션이 받은 패킷은 테스트 스레드가 수신 이벤트를 처리하며 기록한다
+    class RawPeer
+    {
+    public:
+        explicit RawPeer(size_t reassemblyLimit = net::MaxMessageSize)
+            : m_fixture(PipeCapacity,
+                [reassemblyLimit](const net::SessionPtr& session)
+                {
+                    session->setReassemblyLimit(reassemblyLimit);
+                })
+        {}
+
+        const net::SessionPtr& getSession() const { return m_fixture.getSession(); }
+
+        void write(const std::vector<uint8_t>& data)
+        {
+            m_fixture.write(data.data(), data.size());
+        }
+
+        size_t getReceivedCount()
+        {
+            m_fixture.processReceive(
+                [this](const net::PacketView& packet)
+                {
+                    m_received.emplace_back(packet.payload, packet.payload + packet.payloadSize);
+                });
+
+            return m_received.size();
+        }
+
+        const std::vector<uint8_t>& getReceived(size_t index) const { return m_received[index]; }
+
+        // 재조립은 패킷을 꺼낼 때 하므로 받은 패킷을 처리한 뒤 확인
+        bool isClosed()
+        {
+            getReceivedCount();
+            return m_fixture.isClosed();
+        }
+
+    private:
+        test::LoopbackSessionFixture m_fixture;
+        std::vector<std::vector<uint8_t>> m_received;
+    };
+
+    void appendPacket(std::vector<uint8_t>& out, net::PacketId id, const uint8_t* data, size_t size, const net::FragmentHeader* fragmentHeader = nullptr)
+    {
+        const size_t fragmentHeaderSize = fragmentHeader ? sizeof(net::FragmentHeader) : 0;
+
+        net::PacketHeader header;
+        header.size = static_cast<net::PacketSize>(sizeof(net::PacketHeader) + fragmentHeaderSize + size);
+        header.id = id;
+
+        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+        out.insert(out.end(), headerBytes, headerBytes + sizeof(header));
+        if (fragmentHeader)
+        {
+            const uint8_t* fragmentHeaderBytes = reinterpret_cast<const uint8_t*>(fragmentHeader);
+            out.insert(out.end(), fragmentHeaderBytes, fragmentHeaderBytes + sizeof(net::FragmentHeader));
+        }
+        out.insert(out.end(), data, data + size);
+    }
+
+    // data를 조각 패킷으로 나눈다 (messageSize가 data보다 크면 앞부분 조각만 보낸 상태를 만든다)
+    std::vector<uint8_t> makeFragments(net::PacketId id, const std::vector<uint8_t>& data, size_t messageSize)
+    {
+        std::vector<uint8_t> out;
+
+        net::FragmentHeader fragmentHeader;
+        fragmentHeader.messageSize = static_cast<uint32_t>(messageSize);
+        fragmentHeader.id = id;
+
+        size_t offset = std::min(data.size(), net::FirstFragmentDataSize);
+        appendPacket(out, net::FragmentBeginPacketId, data.data(), offset, &fragmentHeader);
+
+        while (offset < data.size())
+        {
+            const size_t size = std::min(data.size() - offset, net::FragmentDataSize);
+            appendPacket(out, net::FragmentPacketId, data.data() + offset, size);
+            offset += size;
+        }
+
+        return out;
+    }
+
+    // data를 압축한 패킷 하나 (압축이 잘 되는 데이터여야 패킷 하나에 들어간다)
+    std::vector<uint8_t> makeCompressedPacket(net::PacketId id, const std::vector<uint8_t>& data)
+    {
+        std::vector<uint8_t> compressed(net::PacketCompressor::getCompressBound(net::CompressionCodec::Zstd, data.size()) + sizeof(net::CompressionHeader));
+
+        net::CompressionHeader compressionHeader;
+        compressionHeader.originalSize = static_cast<uint32_t>(data.size());
+        compressionHeader.id = id;
+        compressionHeader.codec = net::CompressionCodec::Zstd;
+        std::memcpy(compressed.data(), &compressionHeader, sizeof(compressionHeader));
+
+        const size_t compressedSize = net::PacketCompressor::compress(
+            net::CompressionCodec::Zstd, data.data(), data.size(),
+            compressed.data() + sizeof(compressionHeader), compressed.size() - sizeof(compressionHeader));
+        compressed.resize(sizeof(compressionHeader) + compressedSize);
+
+        std::vector<uint8_t> out;
+        appendPacket(out, net::CompressedPacketId, compressed.data(), compressed.size());
+        return out;
+    }
+
+    std::vector<uint8_t> makeMessage(size_t size)
+    {
+        std::vector<uint8_t> message(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            message[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+
+        return message;
+    }
+}
+
+// 조각으로 받은 메시지를 그대로 재조립하고, 끝나면 전체 재조립 예약을 반환한다
+TEST_CASE(Reassembly_LargeMessage_RoundTrip)
+{
+    const std::vector<uint8_t> message = makeMessage(100 * 1024);
+
+    {
+        RawPeer peer;
+        peer.write(makeFragments(1234, message, message.size()));
+
+        CHECK(test::waitUntil([&peer]() { return 0 < peer.getReceivedCount(); }, 1s));
+        CHECK(peer.getSession()->isRunning());
+        CHECK(peer.getReceived(0) == message);
+        CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+
+        // 같은 세션에서 한 번 더 받아도 이전 재조립이 남지 않는다
+        peer.write(makeFragments(1234, message, message.size()));
+        CHECK(test::waitUntil([&peer]() { return 1 < peer.getReceivedCount(); }, 1s));
+        CHECK(peer.getReceived(1) == message);
+    }
+
+    CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+}
+
+// 세션 한도보다 큰 크기를 알리는 첫 조각은 데이터를 받기 전에 연결을 끊는다
+TEST_CASE(Reassembly_SessionLimit_Disconnects)
+{
+    RawPeer peer(64 * 1024);
+    peer.write(makeFragments(1234, makeMessage(net::FirstFragmentDataSize), net::MaxMessageSize));
+
+    CHECK(test::waitUntil([&peer]() { return peer.isClosed(); }, 1s));
+    CHECK(peer.getReceivedCount() == 0);
+    CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+}
+
+// 전체 한도는 재조립 중인 모든 세션이 알린 크기의 합으로 검사하고, 세션이 사라지면 예약을 반환한다
+TEST_CASE(Reassembly_GlobalLimit_RejectsOverBudgetSessions)
+{
+    constexpr size_t MessageSize = 200 * 1024;
+    net::Session::setGlobalReassemblyLimit(256 * 1024);
+
+    {
+        RawPeer first;
+        first.write(makeFragments(1234, makeMessage(net::FirstFragmentDataSize), MessageSize));
+        CHECK(test::waitUntil([&first]() { first.getReceivedCount(); return net::Session::getGlobalReassemblyBytes() == MessageSize; }, 1s));
+
+        RawPeer second;
+        second.write(makeFragments(1234, makeMessage(net::FirstFragmentDataSize), MessageSize));
+        CHECK(test::waitUntil([&second]() { return second.isClosed(); }, 1s));
+
+        CHECK(first.getSession()->isRunning());
+        CHECK(net::Session::getGlobalReassemblyBytes() == MessageSize);
+    }
+
+    net::Session::setGlobalReassemblyLimit(net::Session::DefaultGlobalReassemblyLimit);
+    CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+}
+
+// 작은 압축 패킷이 알린 압축 해제 크기도 세션 한도로 검사하고, 풀기 전에 연결을 끊는다
+TEST_CASE(Reassembly_DecompressSessionLimit_Disconnects)
+{
+    const std::vector<uint8_t> message(256 * 1024, 0x5A);
+    const std::vector<uint8_t> packet = makeCompressedPacket(1234, message);
+    CHECK(packet.size() <= net::MaxPacketSize);
+
+    RawPeer peer(64 * 1024);
+    peer.write(packet);
+
+    CHECK(test::waitUntil([&peer]() { return peer.isClosed(); }, 1s));
+    CHECK(peer.getReceivedCount() == 0);
+    CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+}
+
+// 압축을 푼 메시지는 꺼내는 동안 전체 한도에서 예약하고, 예약할 수 없으면 연결을 끊는다
+TEST_CASE(Reassembly_DecompressGlobalLimit_RejectsOverBudgetSessions)
+{
+    const std::vector<uint8_t> message(200 * 1024, 0x5A);
+    const std::vector<uint8_t> packet = makeCompressedPacket(1234, message);
+
+    {
+        RawPeer peer;
+        peer.write(packet);
+
+        CHECK(test::waitUntil([&peer]() { return 0 < peer.getReceivedCount(); }, 1s));
+        CHECK(peer.getReceived(0) == message);
+        CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+    }
+
+    net::Session::setGlobalReassemblyLimit(128 * 1024);
+
+    {
+        RawPeer peer;
+        peer.write(packet);
+
+        CHECK(test::waitUntil([&peer]() { return peer.isClosed(); }, 1s));
+        CHECK(peer.getReceivedCount() == 0);
+    }
+
+    net::Session::setGlobalReassemblyLimit(net::Session::DefaultGlobalReassemblyLimit);
+    CHECK(net::Session::getGlobalReassemblyBytes() == 0);
+}
@@ -0,0 +1,202 @@
+﻿#include "Test.h"
+#include "LoopbackSessionFixture.h"
+#include "Network/Buffer.h"
+#include <cstring>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr size_t ChunkSize = 1024;
+
+    // 데이터를 전혀 읽지 않는 클라이언트에 연결된 서버 세션
+    // 파이프가 가득 차면 쓰기가 끝나지 않으므로 이후의 송신은 모두 세션의 송신 큐에 쌓인다
+    class NonReadingClient
+    {
+    public:
+        static constexpr size_t PipeCapacity = 16 * 1024;
+
+    public:
+        // sessionManager를 넘기면 세션을 시작하기 전에 등록
+        explicit NonReadingClient(const net::SendQueueConfig& config, net::SessionManager* sessionManager = nullptr)
+            : m_fixture(
+                PipeCapacity,
+                [&config, sessionManager](const net::SessionPtr& session)
+                {
+                    session->setSendQueueConfig(config);
+                    if (sessionManager)
+                    {
+                        sessionManager->addSession(session);
+                    }
+                })
+        {}
+
+        const net::SessionPtr& getSession() const { return m_fixture.getSession(); }
+
+        // 보낸 청크가 모두 송신 큐에 들어갔거나 (전송, 버림, 병합) 처리될 때까지 대기
+        bool waitUntilSettled(size_t sentCount)
+        {
+            const net::SessionPtr& session = getSession();
+            return test::waitUntil(
+                [&session, sentCount]()
+                {
+                    const uint64_t settledCount =
+                        session->getSentChunkCount() +
+                        session->getQueuedChunkCount() +
+                        session->getDroppedChunkCount() +
+                        session->getCoalescedChunkCount();
+
+                    return (sentCount <= settledCount) || !session->isRunning();
+                },
+                2s);
+        }
+
+        bool isClosed() { return m_fixture.isClosed(); }
+
+    private:
+        test::LoopbackSessionFixture m_fixture;
+    };
+
+    net::SendBufferChunkPtr makeChunk(bool droppable, uint64_t coalesceKey = 0)
+    {
+        net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(ChunkSize);
+        std::memset(chunk->getWritePtr(), 0, ChunkSize);
+        chunk->onWritten(ChunkSize);
+        chunk->close();
+
+        chunk->setDroppable(droppable);
+        chunk->setCoalesceKey(coalesceKey);
+
+        return chunk;
+    }
+
+    net::SendQueueConfig makeConfig(net::SendQueuePolicy policy)
+    {
+        net::SendQueueConfig config;
+        config.highWatermark = 64 * 1024;
+        config.lowWatermark = 16 * 1024;
+        config.hardLimit = 1024 * 1024;
+        config.policy = policy;
+        config.disconnectGracePeriod = 10s;
+
+        return config;
+    }
+}
+
+// 읽지 않는 클라이언트에 hard limit의 4배를 보내도 droppable 청크를 버려 큐가 high watermark 근처에 머문다
+TEST_CASE(SendQueue_DropOldest_BoundsMemory)
+{
+    const net::SendQueueConfig config = makeConfig(net::SendQueuePolicy::DropOldest);
+    NonReadingClient client(config);
+    const net::SessionPtr& session = client.getSession();
+
+    constexpr size_t SendCount = 4096;
+    for (size_t i = 0; i < SendCount; ++i)
+    {
+        session->send(makeChunk(true));
+    }
+
+    CHECK(client.waitUntilSettled(SendCount));
+    CHECK(session->isRunning());
+    CHECK(0 < session->getDroppedChunkCount());
+    CHECK(session->getPeakQueuedBytes() <= config.highWatermark + ChunkSize);
+    CHECK(session->getQueuedBytes() <= config.highWatermark);
+}
+
+// 큐가 high watermark를 넘은 뒤 송신이 멈춰도 유예 시간이 지나면 타이머가 연결을 끊는다
+TEST_CASE(SendQueue_GraceTimer_DisconnectsWithoutFurtherSends)
+{
+    net::SendQueueConfig config = makeConfig(net::SendQueuePolicy::Disconnect);
+    config.disconnectGracePeriod = 200ms;
+    NonReadingClient client(config);
+    const net::SessionPtr& session = client.getSession();
+
+    constexpr size_t SendCount = 128;
+    for (size_t i = 0; i < SendCount; ++i)
+    {
+        session->send(makeChunk(false));
+    }
+
+    CHECK(client.waitUntilSettled(SendCount));
+    CHECK(session->isRunning());
+    CHECK(config.highWatermark < session->getQueuedBytes());
+
+    const auto startTime = std::chrono::steady_clock::now();
+    CHECK(test::waitUntil([&client]() { return client.isClosed(); }, 2s));
+    CHECK(100ms <= (std::chrono::steady_clock::now() - startTime));
+    CHECK(!session->isRunning());
+}
+
+// hard limit을 넘으면 유예 없이 바로 연결을 끊는다
+TEST_CASE(SendQueue_HardLimit_DisconnectsImmediately)
+{
+    net::SendQueueConfig config = makeConfig(net::SendQueuePolicy::Disconnect);
+    config.hardLimit = 128 * 1024;
+    NonReadingClient client(config);
+    const net::SessionPtr& session = client.getSession();
+
+    constexpr size_t SendCount = 256;
+    for (size_t i = 0; i < SendCount; ++i)
+    {
+        session->send(makeChunk(false));
+    }
+
+    CHECK(test::waitUntil([&client]() { return client.isClosed(); }, 1s));
+    CHECK(session->getPeakQueuedBytes() <= config.hardLimit + ChunkSize);
+}
+
+// 송신이 멈춘 세션에는 브로드캐스트가 droppable 청크를 보내지 않는다
+TEST_CASE(SendQueue_PauseProducers_SkipsDroppableBroadcast)
+{
+    const net::SendQueueConfig config = makeConfig(net::SendQueuePolicy::PauseProducers);
+    net::SessionManager sessionManager;
+    NonReadingClient client(config, &sessionManager);
+    const net::SessionPtr& session = client.getSession();
+
+    constexpr size_t SendCount = 128;
+    for (size_t i = 0; i < SendCount; ++i)
+    {
+        session->send(makeChunk(false));
+    }
+
+    CHECK(client.waitUntilSettled(SendCount));
+    CHECK(session->isSendPaused());
+
+    const std::vector<net::SessionId> sessionIds = { session->getSessionId() };
+
+    size_t pausedCount = 0;
+    CHECK(sessionManager.broadcast(sessionIds, makeChunk(true), pausedCount) == 0);
+    CHECK(pausedCount == 1);
+
+    CHECK(sessionManager.broadcast(sessionIds, makeChunk(false), pausedCount) == 1);
+    CHECK(pausedCount == 0);
+}
+
+// high watermark 위에서는 같은 병합 키의 청크가 대기 중인 청크를 교체하므로 큐가 늘어나지 않는다
+TEST_CASE(SendQueue_Coalesce_ReplacesQueuedChunk)
+{
+    const net::SendQueueConfig config = makeConfig(net::SendQueuePolicy::Coalesce);
+    NonReadingClient client(config);
+    const net::SessionPtr& session = client.getSession();
+
+    constexpr size_t FillCount = 128;
+    for (size_t i = 0; i < FillCount; ++i)
+    {
+        session->send(makeChunk(false));
+    }
+
+    CHECK(client.waitUntilSettled(FillCount));
+    const size_t queuedBytes = session->getQueuedBytes();
+    CHECK(config.highWatermark < queuedBytes);
+
+    constexpr uint64_t CoalesceKey = 7;
+    constexpr size_t CoalesceCount = 256;
+    for (size_t i = 0; i < CoalesceCount; ++i)
+    {
+        session->send(makeChunk(false, CoalesceKey));
+    }
+
+    CHECK(client.waitUntilSettled(FillCount + CoalesceCount));
+    CHECK(session->getQueuedBytes() <= queuedBytes + ChunkSize);
+    CHECK(CoalesceCount - 1 <= session->getCoalescedChunkCount());
+}
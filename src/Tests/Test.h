@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 외부 프레임워크 없이 사용하는 최소한의 테스트 등록/검사 도구
+namespace test
+{
+    using TestFunction = void(*)();
+
+    struct TestCase
+    {
+        const char* name = nullptr;
+        TestFunction function = nullptr;
+    };
+
+    std::vector<TestCase>& getTestCases();
+
+    // 실패를 기록하고 테스트는 계속 진행 (실행기가 테스트가 끝난 뒤 실패 수를 확인)
+    void fail(const char* file, int line, const char* expression);
+    size_t getFailureCount();
+
+    class TestRegistrar
+    {
+    public:
+        TestRegistrar(const char* name, TestFunction function)
+        {
+            getTestCases().push_back({ name, function });
+        }
+    };
+
+    // predicate가 참이 되거나 timeout이 지날 때까지 대기하고 마지막 결과 반환
+    template<typename TPredicate>
+    bool waitUntil(TPredicate&& predicate, std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (deadline <= std::chrono::steady_clock::now())
+            {
+                return predicate();
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static test::TestRegistrar s_testRegistrar_##name(#name, &name); \
+    static void name()
+
+#define CHECK(expression) \
+    do \
+    { \
+        if (!(expression)) \
+        { \
+            test::fail(__FILE__, __LINE__, #expression); \
+        } \
+    } while (false)
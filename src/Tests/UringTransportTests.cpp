@@ -0,0 +1,261 @@
+﻿#include "Test.h"
+#include "Network/Service.h"
+#include "Network/Event.h"
+#include "Network/Packet.h"
+#include <atomic>
+#include <numeric>
+
+#if defined(BYTEBORNE_HAS_IO_URING)
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint16_t TestPort = 12347;
+    constexpr net::PacketId EchoPacketId = 1;
+
+    // io_uring 전송 계층으로 수락한 세션이 받은 패킷을 그대로 돌려보내는 서버
+    // WorldServer처럼 이벤트 스레드가 수신 이벤트를 처리하며, paused 동안에는 패킷을 처리하지 않고 다음 읽기도 요청하지 않는다
+    class UringEchoServer
+    {
+    public:
+        explicit UringEchoServer(net::IoThreadModel threadModel)
+            : m_ioThreadPool(2, threadModel)
+        {
+            m_service = net::ServerService::createInstance(
+                m_ioThreadPool, m_serviceEventQueue, TestPort,
+                [this](net::SessionTransportPtr&& transport)
+                {
+                    return net::Session::createInstance(std::move(transport), m_sessionEventQueue, m_ioThreadPool.getThreadModel());
+                });
+            m_service->setTransportBackend(net::TransportBackend::Uring);
+
+            m_ioThreadPool.run();
+            m_service->start();
+
+            m_eventThread = std::thread(
+                [this]()
+                {
+                    while (m_running.load())
+                    {
+                        processEvents();
+                        std::this_thread::sleep_for(1ms);
+                    }
+                });
+        }
+
+        ~UringEchoServer()
+        {
+            m_running = false;
+            m_eventThread.join();
+
+            m_service->stop();
+            if (m_session)
+            {
+                m_session->stop();
+            }
+
+            test::waitUntil([this]() { processEvents(); return m_closed.load(); }, 1s);
+
+            // 서비스가 닫히기 전에 IO 스레드를 멈추면 리스닝 소켓이 남아 다음 테스트가 같은 포트에 바인딩하지 못한다
+            test::waitUntil([this]() { processEvents(); return m_serviceClosed; }, 1s);
+
+            m_ioThreadPool.stop();
+            m_ioThreadPool.join();
+        }
+
+        // 이벤트 스레드가 세션을 수락해 시작할 때까지 대기
+        bool acceptSession()
+        {
+            return test::waitUntil([this]() { return m_accepted.load(); }, 1s);
+        }
+
+        void pause() { m_paused = true; }
+        void resume() { m_paused = false; }
+
+        // 세션의 Close 이벤트를 받았는지
+        bool isClosed() const { return m_closed.load(); }
+
+        net::ServerService& getService() { return *m_service; }
+
+    private:
+        void processEvents()
+        {
+            net::ServiceEventPtr serviceEvent;
+            while (m_serviceEventQueue.pop(serviceEvent))
+            {
+                if (serviceEvent->type == net::ServiceEventType::Close)
+                {
+                    m_serviceClosed = true;
+                }
+                else if (serviceEvent->type == net::ServiceEventType::Accept)
+                {
+                    m_session = static_cast<net::ServiceAcceptEvent*>(serviceEvent.get())->session;
+                    m_session->start();
+                    m_accepted = true;
+                }
+            }
+
+            net::SessionEventPtr sessionEvent;
+            while (m_sessionEventQueue.pop(sessionEvent))
+            {
+                if (sessionEvent->type == net::SessionEventType::Receive)
+                {
+                    m_receivePending = true;
+                }
+                else if (sessionEvent->type == net::SessionEventType::Close)
+                {
+                    m_closed = true;
+                }
+            }
+
+            if (m_receivePending && !m_paused.load())
+            {
+                m_receivePending = false;
+                echo(m_session);
+            }
+        }
+
+        static void echo(const net::SessionPtr& session)
+        {
+            net::PacketView packet;
+            while (session->getFrontPacket(packet))
+            {
+                const size_t totalSize = sizeof(net::PacketHeader) + packet.payloadSize;
+                net::SendBufferChunkPtr chunk = net::SendBufferManager::getLocal().open(totalSize);
+
+                auto* header = reinterpret_cast<net::PacketHeader*>(chunk->getWritePtr());
+                header->size = static_cast<net::PacketSize>(totalSize);
+                header->id = packet.id;
+                std::memcpy(header + 1, packet.payload, packet.payloadSize);
+
+                chunk->onWritten(totalSize);
+                chunk->close();
+
+                session->send(chunk);
+                session->popFrontPacket();
+            }
+
+            session->receive();
+        }
+
+    private:
+        net::IoThreadPool m_ioThreadPool;
+        net::ServiceEventQueue m_serviceEventQueue;
+        net::SessionEventQueue m_sessionEventQueue;
+        net::ServerServicePtr m_service;
+        net::SessionPtr m_session;
+        std::thread m_eventThread;
+        std::atomic<bool> m_running = true;
+        std::atomic<bool> m_accepted = false;
+        std::atomic<bool> m_paused = false;
+        std::atomic<bool> m_closed = false;
+        bool m_receivePending = false;
+        bool m_serviceClosed = false;
+    };
+
+    // 패킷마다 다른 바이트로 채운 packetCount개의 패킷
+    std::vector<uint8_t> makePackets(size_t payloadSize, size_t packetCount)
+    {
+        const size_t packetSize = sizeof(net::PacketHeader) + payloadSize;
+        std::vector<uint8_t> packets(packetSize * packetCount);
+
+        for (size_t i = 0; i < packetCount; ++i)
+        {
+            uint8_t* packet = packets.data() + i * packetSize;
+            auto* header = reinterpret_cast<net::PacketHeader*>(packet);
+            header->size = static_cast<net::PacketSize>(packetSize);
+            header->id = EchoPacketId;
+            std::iota(packet + sizeof(net::PacketHeader), packet + packetSize, static_cast<uint8_t>(i));
+        }
+
+        return packets;
+    }
+
+    // 보낸 패킷이 순서와 내용 그대로 돌아오고, 연결을 끊으면 세션이 닫히는지 확인
+    void checkEcho(net::IoThreadModel threadModel)
+    {
+        UringEchoServer server(threadModel);
+        CHECK(server.getService().getTransportBackend() == net::TransportBackend::Uring);
+
+        asio::io_context ioContext;
+        asio::ip::tcp::socket client(ioContext);
+        client.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), TestPort));
+        CHECK(server.acceptSession());
+
+        // 제공 버퍼 하나보다 큰 쓰기와 여러 번에 걸친 부분 수신을 모두 거치도록 큰 덩어리로 보낸다
+        const std::vector<uint8_t> packets = makePackets(1000, 256);
+        std::vector<uint8_t> reply(packets.size());
+        for (size_t i = 0; i < 4; ++i)
+        {
+            asio::write(client, asio::buffer(packets));
+            asio::read(client, asio::buffer(reply));
+            CHECK(reply == packets);
+        }
+
+        client.close();
+        CHECK(test::waitUntil([&server]() { return server.isClosed(); }, 1s));
+    }
+}
+
+// 스레드마다 io_context(와 링)를 두는 모델: SO_REUSEPORT acceptor마다 multishot accept
+TEST_CASE(UringTransport_EchoesWithContextPerThread)
+{
+    if (!net::isTransportBackendAvailable(net::TransportBackend::Uring))
+    {
+        spdlog::info("[Test] io_uring을 사용할 수 없어 건너뜀");
+        return;
+    }
+
+    checkEcho(net::IoThreadModel::ContextPerThread);
+}
+
+// 여러 IO 스레드가 링 하나를 공유하고 세션은 strand에서 완료를 처리하는 모델
+TEST_CASE(UringTransport_EchoesWithSharedContext)
+{
+    if (!net::isTransportBackendAvailable(net::TransportBackend::Uring))
+    {
+        spdlog::info("[Test] io_uring을 사용할 수 없어 건너뜀");
+        return;
+    }
+
+    checkEcho(net::IoThreadModel::SharedContext);
+}
+
+// 세션이 읽지 않는 동안 받은 데이터는 전송 계층 한도까지만 쌓이고, 나머지는 소켓에 남아 있다가 다시 읽으면 순서대로 전달된다
+TEST_CASE(UringTransport_StopsReceivingWhileSessionIsPaused)
+{
+    if (!net::isTransportBackendAvailable(net::TransportBackend::Uring))
+    {
+        spdlog::info("[Test] io_uring을 사용할 수 없어 건너뜀");
+        return;
+    }
+
+    UringEchoServer server(net::IoThreadModel::ContextPerThread);
+
+    asio::io_context ioContext;
+    asio::ip::tcp::socket client(ioContext);
+    client.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), TestPort));
+    CHECK(server.acceptSession());
+
+    server.pause();
+
+    // 전송 계층 한도의 몇 배를 보내고, 쓰기가 소켓 버퍼에서 막혀도 되도록 별도 스레드에서 보낸다
+    const std::vector<uint8_t> packets = makePackets(1000, 20 * net::UringTransport::MaxBufferedBytes / 1000);
+    std::thread writer(
+        [&client, &packets]()
+        {
+            asio::write(client, asio::buffer(packets));
+        });
+
+    std::this_thread::sleep_for(50ms);
+    server.resume();
+
+    std::vector<uint8_t> reply(packets.size());
+    asio::read(client, asio::buffer(reply));
+    writer.join();
+    CHECK(reply == packets);
+
+    client.close();
+    CHECK(test::waitUntil([&server]() { return server.isClosed(); }, 1s));
+}
+#endif // BYTEBORNE_HAS_IO_URING
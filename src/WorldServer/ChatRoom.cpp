@@ -56,23 +56,20 @@ void ChatRoom::handleChat(net::SessionId sessionId, const proto::C2S_Chat& messa
 
     net::SendBufferChunkPtr chunk = m_serializer.serializeToSendBuffer(response);
 
-    // 브로드캐스트 (활성 세션 모두)
-    bool anySent = false;
-    for (const auto& sid : m_activeSessions)
-    {
-        if (m_sessionManager.send(sid, chunk))
-        {
-            anySent = true;
-        }
-        else
-        {
-            spdlog::warn("[ChatRoom] 세션 {}에 S2C_Chat 전송 실패", sid);
-        }
-    }
+    // 읽지 않는 클라이언트의 송신 큐가 밀리면 오래된 채팅부터 버리거나 (DropOldest) 보내지 않는다 (PauseProducers)
+    chunk->setDroppable(true);
 
-    if (!anySent)
+    // 브로드캐스트 (활성 세션 모두, IO 실행기별로 묶어서 전송)
+    // 송신 큐가 밀려 생산자에게 멈춤을 알린 세션은 큐가 줄어들 때까지 채팅을 건너뛴다
+    size_t pausedCount = 0;
+    const size_t recipientCount = m_sessionManager.broadcast(m_activeSessions, chunk, pausedCount);
+    if ((recipientCount == 0) && (pausedCount == 0))
     {
         spdlog::warn("[ChatRoom] 브로드캐스트 대상 세션이 없습니다.");
     }
+    else if (recipientCount + pausedCount < m_activeSessions.size())
+    {
+        spdlog::warn("[ChatRoom] {}개 세션에 S2C_Chat 전송 실패", m_activeSessions.size() - recipientCount - pausedCount);
+    }
 }
 
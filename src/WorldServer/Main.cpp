@@ -1,12 +1,35 @@
 ﻿#include "Core/Context.h"
 #include "Server.h"
 
-int main()
+// 사용법: WorldServer [--local-socket[=경로]]
+// --local-socket을 주면 같은 호스트의 보조 프로세스용 유닉스 도메인 소켓도 연다 (경로를 생략하면 $XDG_RUNTIME_DIR/byteborne/world.sock)
+int main(int argc, char* argv[])
 {
     core::AppContext::getInstance().initialize();
 
     {
         WorldServer server;
+
+        constexpr std::string_view LocalSocketOption = "--local-socket";
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument(argv[i]);
+            if (argument == LocalSocketOption)
+            {
+                server.openLocalService();
+            }
+            else if ((LocalSocketOption.size() < argument.size()) &&
+                (argument.substr(0, LocalSocketOption.size()) == LocalSocketOption) &&
+                (argument[LocalSocketOption.size()] == '='))
+            {
+                server.openLocalService(std::string(argument.substr(LocalSocketOption.size() + 1)));
+            }
+            else
+            {
+                spdlog::warn("[WorldServer] 알 수 없는 인자: {}", argument);
+            }
+        }
+
         server.start();
 
 #ifdef _DEBUG
@@ -3,16 +3,142 @@
 #include "Protocol/Type.h"
 #include "Protocol/Serializer.h"
 #include <chrono>
+#include <filesystem>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+namespace
+{
+    // 클라이언트 하트비트 간격(5초)의 3배 동안 아무것도 수신하지 못하면 연결 종료
+    constexpr auto SessionIdleTimeout = std::chrono::seconds(15);
+
+    // 클라이언트가 보내는 메시지는 작으므로 조각 메시지 재조립 한도를 낮게 둔다 (서버가 보내는 스냅샷과 달리)
+    constexpr size_t ClientReassemblyLimit = 1024 * 1024;
+    constexpr size_t GlobalReassemblyLimit = 64 * 1024 * 1024;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+    // 경로를 정하지 않았을 때 개인 런타임 디렉터리에 만드는 소켓 파일 이름
+    constexpr const char* LocalServiceFileName = "world.sock";
+
+    // 사용자 전용 런타임 디렉터리 ($XDG_RUNTIME_DIR/byteborne, 없으면 임시 디렉터리의 byteborne-<uid>)
+    std::filesystem::path getPrivateRuntimeDirectory()
+    {
+        const char* runtimeDirectory = std::getenv("XDG_RUNTIME_DIR");
+        if (runtimeDirectory && (runtimeDirectory[0] != '\0'))
+        {
+            return std::filesystem::path(runtimeDirectory) / "byteborne";
+        }
+
+#if defined(_WIN32)
+        return std::filesystem::temp_directory_path() / "byteborne";
+#else
+        return std::filesystem::temp_directory_path() / ("byteborne-" + std::to_string(::getuid()));
+#endif // _WIN32
+    }
+
+    // 디렉터리를 만들고 소유자만 접근할 수 있게 한다
+    // 다른 사용자가 먼저 만든 디렉터리면 그 사용자가 소켓 파일을 바꿔칠 수 있으므로 사용하지 않는다
+    bool preparePrivateDirectory(const std::filesystem::path& directory)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error)
+        {
+            spdlog::error("[WorldServer] 런타임 디렉터리 생성 실패: {} ({})", directory.string(), error.message());
+            return false;
+        }
+
+#if !defined(_WIN32)
+        struct stat status;
+        if ((::lstat(directory.c_str(), &status) != 0) || !S_ISDIR(status.st_mode) || (status.st_uid != ::getuid()))
+        {
+            spdlog::error("[WorldServer] 현재 사용자의 디렉터리가 아니므로 사용하지 않음: {}", directory.string());
+            return false;
+        }
+#endif // !_WIN32
+
+        std::filesystem::permissions(directory, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace, error);
+        if (error)
+        {
+            spdlog::error("[WorldServer] 런타임 디렉터리 권한 설정 실패: {} ({})", directory.string(), error.message());
+            return false;
+        }
+
+        return true;
+    }
+#endif // ASIO_HAS_LOCAL_SOCKETS
+}
 
 WorldServer::WorldServer()
     : m_running(false)
-    , m_messageSerializer(m_sendBufferManager)
+    , m_ioThreadPool(std::thread::hardware_concurrency(), net::IoThreadModel::ContextPerThread)
+    , m_loopbackConnector(
+        m_ioThreadPool, m_serviceEventQueue,
+        [this](net::SessionTransportPtr&& transport)
+        {
+            return createSession(std::move(transport));
+        })
+    , m_idleSessionMonitor(m_sessionManager, SessionIdleTimeout)
     , m_chatRoom(m_sessionManager, m_messageSerializer)
 {
     m_serverService = net::ServerService::createInstance(
-        m_ioThreadPool.getContext(), m_serviceEventQueue, 12345);
+        m_ioThreadPool, m_serviceEventQueue, 12345,
+        [this](net::SessionTransportPtr&& transport)
+        {
+            // 세션을 배정한 io_context의 IO 스레드에서 호출되며, 세션은 그 io_context에 남는다
+            return createSession(std::move(transport));
+        });
+
+    net::Session::setGlobalReassemblyLimit(GlobalReassemblyLimit);
 
     registerMessageHandlers();
+    configureRateLimits();
+    configureCompression();
+}
+
+bool WorldServer::openLocalService(const std::string& path)
+{
+    assert(!m_running.load());
+    assert(!m_localService);
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+    std::string socketPath = path;
+    if (socketPath.empty())
+    {
+        const std::filesystem::path directory = getPrivateRuntimeDirectory();
+        if (!preparePrivateDirectory(directory))
+        {
+            return false;
+        }
+
+        socketPath = (directory / LocalServiceFileName).string();
+    }
+
+    try
+    {
+        m_localService = net::ServerService::createInstance(
+            m_ioThreadPool, m_serviceEventQueue, socketPath,
+            [this](net::SessionTransportPtr&& transport)
+            {
+                return createSession(std::move(transport));
+            });
+    }
+    catch (const std::exception& error)
+    {
+        // 보조 프로세스용 연결이 없어도 클라이언트는 받을 수 있으므로 TCP 서비스만으로 계속 실행
+        spdlog::error("[WorldServer] 유닉스 도메인 소켓 서비스를 열지 못했습니다: {} ({})", socketPath, error.what());
+        return false;
+    }
+
+    return true;
+#else
+    (void)path;
+    spdlog::warn("[WorldServer] 유닉스 도메인 소켓을 지원하지 않는 플랫폼입니다.");
+    return false;
+#endif // ASIO_HAS_LOCAL_SOCKETS
 }
 
 void WorldServer::start()
@@ -34,6 +160,10 @@ void WorldServer::start()
     m_ioThreadPool.run();
     
     m_serverService->start();
+    if (m_localService)
+    {
+        m_localService->start();
+    }
 }
 
 void WorldServer::stop()
@@ -47,6 +177,11 @@ void WorldServer::stop()
     spdlog::info("[WorldServer] 서버 중지");
 }
 
+net::SessionTransportPtr WorldServer::connectLoopback(asio::io_context& clientContext)
+{
+    return m_loopbackConnector.connect(clientContext);
+}
+
 void WorldServer::join()
 {
     m_ioThreadPool.join();
@@ -72,6 +207,7 @@ void WorldServer::loop()
         processSessionEvents();
         processMessages();
         m_timer.update();
+        m_idleSessionMonitor.update(std::chrono::steady_clock::now());
         ++tickCount;
 
         auto end = std::chrono::steady_clock::now();
@@ -81,6 +217,8 @@ void WorldServer::loop()
         if (std::chrono::seconds(1) <= tickCountElapsed)
         {
             spdlog::debug("[WorldServer] 틱 카운트: {}", tickCount);
+            logSendBufferStats();
+            logRateLimitStats();
             lastTickCountTime = end;
             tickCount = 0;
         }
@@ -103,6 +241,13 @@ void WorldServer::close()
 
     spdlog::info("[WorldServer] 서버 닫기");
 
+    // 한 서비스만 닫힌 경우에도 남은 서비스의 accept가 IO 스레드를 붙잡지 않도록 모두 중지
+    m_serverService->stop();
+    if (m_localService)
+    {
+        m_localService->stop();
+    }
+
     m_sessionManager.stopAllSessions();
 
     // 서모든 세션이 제거될 때까지 대기
@@ -139,21 +284,33 @@ void WorldServer::processServiceEvents()
 
 void WorldServer::handleServiceEvent(net::ServiceCloseEvent& event)
 {
-    assert(m_running.load());
-
+    // TCP와 유닉스 도메인 소켓 서비스가 중지 신호를 각각 받으므로 close 이벤트가 여러 번 올 수 있다
     stop();
 }
 
+net::SessionPtr WorldServer::createSession(net::SessionTransportPtr&& transport)
+{
+    net::SessionPtr session = net::Session::createInstance(std::move(transport), m_sessionEventQueue, m_ioThreadPool.getThreadModel());
+    session->setReassemblyLimit(ClientReassemblyLimit);
+
+    return session;
+}
+
 void WorldServer::handleServiceEvent(net::ServiceAcceptEvent& event)
 {
+    const net::SessionPtr& session = event.session;
+
     if (!m_running.load())
     {
         spdlog::debug("[WorldServer] 서버가 실행 중이 아닙니다. 클라이언트 수락 이벤트를 건너뜁니다.");
+
+        // 서비스가 수락하면서 반영한 io_context의 부하를 되돌린다
+        m_ioThreadPool.releaseSessionContext(asio::query(session->getExecutor(), asio::execution::context));
         return;
     }
 
-    auto session = net::Session::createInstance(std::move(event.socket), m_sessionEventQueue);
     m_sessionManager.addSession(session);
+    m_idleSessionMonitor.addSession(session);
     m_chatRoom.onClientAccepted(session->getSessionId());
     session->start();
 }
@@ -181,7 +338,15 @@ void WorldServer::processSessionEvents()
 
 void WorldServer::handleSessionEvent(net::SessionCloseEvent& event)
 {
+    auto session = m_sessionManager.findSession(event.sessionId);
+    if (session)
+    {
+        // 세션이 배정받았던 io_context의 부하 감소
+        m_ioThreadPool.releaseSessionContext(asio::query(session->getExecutor(), asio::execution::context));
+    }
+
     m_sessionManager.removeSession(event.sessionId);
+    m_rateLimiter.removeSession(event.sessionId);
     m_chatRoom.onClientClosed(event.sessionId);
 }
 
@@ -196,11 +361,49 @@ void WorldServer::handleSessionEvent(net::SessionReceiveEvent& event)
     auto session = m_sessionManager.findSession(event.sessionId);
     assert(session);
 
+    processReceivedPackets(session);
+}
+
+void WorldServer::processReceivedPackets(const net::SessionPtr& session)
+{
+    const net::SessionId sessionId = session->getSessionId();
+    const auto now = proto::MessageRateLimiter::Clock::now();
+
     net::PacketView packetView;
     while (session->getFrontPacket(packetView))
     {
-        // 패킷의 페이로드를 메시지로 파싱하여 큐에 추가
-        m_messageQueue.push(event.sessionId, packetView);
+        // 파싱하기 전에 수신 속도 제한 확인
+        const auto messageType = static_cast<proto::MessageType>(packetView.id);
+        std::chrono::milliseconds retryAfter(0);
+
+        switch (m_rateLimiter.onPacket(sessionId, messageType, now, retryAfter))
+        {
+        case proto::RateLimitDecision::Accept:
+            // 패킷의 페이로드를 메시지로 파싱하여 큐에 추가
+            m_messageQueue.push(sessionId, packetView);
+            break;
+        case proto::RateLimitDecision::Drop:
+            break;
+        case proto::RateLimitDecision::Delay:
+            // 남은 패킷은 수신 버퍼에 둔 채 토큰이 찰 때까지 수신을 멈춘다
+            m_timer.scheduleOnce(
+                retryAfter,
+                [this, sessionId]()
+                {
+                    auto delayedSession = m_sessionManager.findSession(sessionId);
+                    if (delayedSession && delayedSession->isRunning())
+                    {
+                        processReceivedPackets(delayedSession);
+                    }
+
+                    return false;
+                });
+            return;
+        case proto::RateLimitDecision::Disconnect:
+            spdlog::warn("[WorldServer] 세션 {} 수신 속도 제한 초과로 연결 종료", sessionId);
+            session->stop();
+            return;
+        }
 
         // 수신 버퍼에서 패킷 제거
         session->popFrontPacket();
@@ -219,8 +422,90 @@ void WorldServer::processMessages()
     }
 }
 
+void WorldServer::logSendBufferStats()
+{
+    const net::SendBufferPoolStats stats = net::SendBufferPool::getStats();
+
+    // 직전 로그 이후 송신한 1MB당 시스템 할당 횟수
+    const uint64_t allocatedBlocks = stats.allocatedBlocks - m_lastSendBufferStats.allocatedBlocks;
+    const uint64_t committedBytes = stats.committedBytes - m_lastSendBufferStats.committedBytes;
+    const double committedMegaBytes = static_cast<double>(committedBytes) / (1024.0 * 1024.0);
+    const double allocationsPerMegaByte = (0 < committedBytes) ? (allocatedBlocks / committedMegaBytes) : 0.0;
+
+    spdlog::debug(
+        "[WorldServer] 송신 버퍼: {} bytes, 할당 {} (MB당 {:.2f}), 재사용 {}, 원격 반환 {}, 해제 {}",
+        committedBytes,
+        allocatedBlocks,
+        allocationsPerMegaByte,
+        stats.reusedBlocks - m_lastSendBufferStats.reusedBlocks,
+        stats.remoteReturns - m_lastSendBufferStats.remoteReturns,
+        stats.freedBlocks - m_lastSendBufferStats.freedBlocks);
+
+    m_lastSendBufferStats = stats;
+}
+
+void WorldServer::logRateLimitStats()
+{
+    const proto::RateLimitCounters counters = m_rateLimiter.getCounters();
+    if ((counters.dropped == m_lastRateLimitCounters.dropped) &&
+        (counters.delayed == m_lastRateLimitCounters.delayed) &&
+        (counters.disconnected == m_lastRateLimitCounters.disconnected))
+    {
+        return;
+    }
+
+    spdlog::debug(
+        "[WorldServer] 수신 속도 제한: 허용 {}, 버림 {}, 지연 {}, 연결 종료 {}",
+        counters.accepted - m_lastRateLimitCounters.accepted,
+        counters.dropped - m_lastRateLimitCounters.dropped,
+        counters.delayed - m_lastRateLimitCounters.delayed,
+        counters.disconnected - m_lastRateLimitCounters.disconnected);
+
+    m_lastRateLimitCounters = counters;
+}
+
 void WorldServer::registerMessageHandlers()
 {
+    m_messageDispatcher.registerHandler(
+        proto::MessageType::C2S_Heartbeat,
+        [this](net::SessionId sessionId, const proto::MessagePtr& message)
+        {
+            handleHeartbeat(sessionId, *std::static_pointer_cast<proto::C2S_Heartbeat>(message));
+        });
+
     // 채팅 핸들러를 ChatRoom에 위임
     m_chatRoom.registerMessageHandlers(m_messageDispatcher);
 }
+
+void WorldServer::handleHeartbeat(net::SessionId sessionId, const proto::C2S_Heartbeat& message)
+{
+    // 수신 자체로 유휴 시간이 갱신되므로 클라이언트의 RTT 측정을 위한 응답만 보낸다
+    proto::S2C_Heartbeat response;
+    response.set_client_sent_at_ms(message.client_sent_at_ms());
+    response.set_server_sent_at_ms(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    net::SendBufferChunkPtr chunk = m_messageSerializer.serializeToSendBuffer(response);
+
+    // 송신 큐가 밀린 세션에는 오래된 응답 대신 최신 응답 하나만 남긴다 (SendQueuePolicy::Coalesce)
+    chunk->setCoalesceKey(static_cast<uint64_t>(proto::MessageType::S2C_Heartbeat));
+    m_sessionManager.send(sessionId, chunk);
+}
+
+void WorldServer::configureRateLimits()
+{
+    // 세션 전체: 초과분은 TCP 수신을 멈춰 클라이언트 쪽으로 압력을 되돌린다
+    m_rateLimiter.setSessionLimit({ 100.0, 200.0, proto::RateLimitPolicy::Delay });
+
+    // 채팅: 도배는 파싱하지 않고 버린다
+    m_rateLimiter.setMessageLimit(proto::MessageType::C2S_Chat, { 10.0, 20.0, proto::RateLimitPolicy::Drop });
+}
+
+void WorldServer::configureCompression()
+{
+    // 채팅 브로드캐스트는 청크 하나를 모든 세션이 공유하므로 메시지당 한 번만 압축된다
+    // 작은 메시지는 압축 이득보다 헤더와 CPU 비용이 크므로 일정 크기 이상만 압축
+    m_messageSerializer.setCompressionPolicy(
+        proto::MessageType::S2C_Chat,
+        { proto::CompressionMode::AboveSize, 256, net::CompressionCodec::Lz4 });
+}
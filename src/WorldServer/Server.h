@@ -5,8 +5,11 @@
 #include "Network/Session.h"
 #include "Network/Service.h"
 #include "Network/Event.h"
+#include "Network/IdleMonitor.h"
+#include "Network/Loopback.h"
 #include "Protocol/Dispatcher.h"
 #include "Protocol/Serializer.h"
+#include "Protocol/RateLimiter.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <atomic>
@@ -18,14 +21,24 @@ class WorldServer
 public:
     WorldServer();
 
+    // 같은 호스트의 보조 프로세스(채팅 기록, 모더레이션, 지표 수집)가 접속할 유닉스 도메인 소켓도 연다 (start() 전에 호출, 기본으로는 열지 않는다)
+    // 경로가 비어 있으면 사용자 전용 런타임 디렉터리에 만들고, 열지 못하면 로그만 남긴 채 TCP 서비스만으로 실행한다
+    bool openLocalService(const std::string& path = std::string());
+
     void start();
     void stop();
     void join();
 
+    // 커널을 거치지 않는 프로세스 내부 연결 (벤치마크, 시뮬레이션 클라이언트용)
+    // 반환한 전송 계층으로 클라이언트 세션을 만들면 서버 쪽 세션은 TCP로 수락한 세션과 똑같이 처리된다
+    net::SessionTransportPtr connectLoopback(asio::io_context& clientContext);
+
 private:
     void loop();
     void close();
 
+    net::SessionPtr createSession(net::SessionTransportPtr&& transport);
+
     void processServiceEvents();
     void handleServiceEvent(net::ServiceCloseEvent& event);
     void handleServiceEvent(net::ServiceAcceptEvent& event);
@@ -33,9 +46,15 @@ private:
     void processSessionEvents();
     void handleSessionEvent(net::SessionCloseEvent& event);
     void handleSessionEvent(net::SessionReceiveEvent& event);
+    void processReceivedPackets(const net::SessionPtr& session);
 
     void processMessages();
     void registerMessageHandlers();
+    void handleHeartbeat(net::SessionId sessionId, const proto::C2S_Heartbeat& message);
+    void configureRateLimits();
+    void configureCompression();
+    void logSendBufferStats();
+    void logRateLimitStats();
 
 private:
     std::atomic<bool> m_running;
@@ -44,12 +63,17 @@ private:
     net::IoThreadPool m_ioThreadPool;
     net::ServiceEventQueue m_serviceEventQueue;
     net::ServerServicePtr m_serverService;
+    net::ServerServicePtr m_localService; // openLocalService()로 열지 않았으면 nullptr
+    net::LoopbackConnector m_loopbackConnector;
     net::SessionEventQueue m_sessionEventQueue;
     net::SessionManager m_sessionManager;
-    net::SendBufferManager m_sendBufferManager;
+    net::IdleSessionMonitor m_idleSessionMonitor;
     proto::MessageQueue m_messageQueue;
+    proto::MessageRateLimiter m_rateLimiter;
     proto::MessageDispatcher m_messageDispatcher;
     proto::MessageSerializer m_messageSerializer;
+    net::SendBufferPoolStats m_lastSendBufferStats;
+    proto::RateLimitCounters m_lastRateLimitCounters;
 
     // 채팅은 ChatRoom으로 위임
     world::ChatRoom m_chatRoom{ m_sessionManager, m_messageSerializer };